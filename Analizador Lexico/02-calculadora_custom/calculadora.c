@@ -1,243 +1,17 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
-
-/* Definición de tokens */
-typedef enum {
-    TOKEN_EOF = 0,
-    TOKEN_NUMERO = 1,
-    TOKEN_SUMA = 2,
-    TOKEN_RESTA = 3,
-    TOKEN_MULTIPLICACION = 4,
-    TOKEN_DIVISION = 5,
-    TOKEN_PARENTESIS_IZQ = 6,
-    TOKEN_PARENTESIS_DER = 7,
-    TOKEN_ASIGNACION = 8,
-    TOKEN_IDENTIFICADOR = 9,
-    TOKEN_FIN_LINEA = 10,
-    TOKEN_ERROR = -1
-} TipoToken;
-
-/* Estructura para representar un token */
-typedef struct {
-    TipoToken tipo;
-    double valor_numerico;
-    char lexema[256];
-    int linea;
-    int columna;
-} Token;
-
-/* Variables globales del analizador */
-static FILE *entrada = NULL;
-static int caracter_actual = 0;
-static int linea_actual = 1;
-static int columna_actual = 1;
-static int fin_archivo = 0;
+#include <unistd.h>
+#include "lexer.h"
 
 /* Prototipos de funciones */
-void inicializar_analizador(FILE *archivo);
-int leer_caracter(void);
-void retroceder_caracter(void);
-void saltar_espacios(void);
-Token leer_numero(void);
-Token leer_identificador(void);
-Token obtener_siguiente_token(void);
 void imprimir_token(Token token);
 const char* nombre_token(TipoToken tipo);
-
-/* Inicializar el analizador lexicográfico */
-void inicializar_analizador(FILE *archivo) {
-    entrada = archivo;
-    caracter_actual = 0;
-    linea_actual = 1;
-    columna_actual = 1;
-    fin_archivo = 0;
-}
-
-/* Leer el siguiente caracter del archivo */
-int leer_caracter(void) {
-    if (fin_archivo) {
-        return EOF;
-    }
-    
-    caracter_actual = fgetc(entrada);
-    
-    if (caracter_actual == EOF) {
-        fin_archivo = 1;
-        return EOF;
-    }
-    
-    if (caracter_actual == '\n') {
-        linea_actual++;
-        columna_actual = 1;
-    } else {
-        columna_actual++;
-    }
-    
-    return caracter_actual;
-}
-
-/* Retroceder un caracter (simulación simple) */
-void retroceder_caracter(void) {
-    if (!fin_archivo && caracter_actual != EOF) {
-        ungetc(caracter_actual, entrada);
-        if (caracter_actual == '\n') {
-            linea_actual--;
-        } else {
-            columna_actual--;
-        }
-    }
-}
-
-/* Saltar espacios en blanco y tabulaciones */
-void saltar_espacios(void) {
-    while (leer_caracter() != EOF && (caracter_actual == ' ' || caracter_actual == '\t')) {
-        /* Continuar leyendo hasta encontrar un caracter no-espacio */
-    }
-    
-    /* Retroceder el último caracter leído si no es espacio */
-    if (caracter_actual != EOF && caracter_actual != ' ' && caracter_actual != '\t') {
-        retroceder_caracter();
-    }
-}
-
-/* Leer un número (entero o decimal) */
-Token leer_numero(void) {
-    Token token;
-    char buffer[256];
-    int indice = 0;
-    int tiene_punto = 0;
-    
-    token.tipo = TOKEN_NUMERO;
-    token.linea = linea_actual;
-    token.columna = columna_actual;
-    
-    /* Leer dígitos y posible punto decimal */
-    while (leer_caracter() != EOF) {
-        if (isdigit(caracter_actual)) {
-            buffer[indice++] = caracter_actual;
-        } else if (caracter_actual == '.' && !tiene_punto) {
-            tiene_punto = 1;
-            buffer[indice++] = caracter_actual;
-        } else {
-            /* Caracter no pertenece al número, retroceder */
-            retroceder_caracter();
-            break;
-        }
-    }
-    
-    buffer[indice] = '\0';
-    strcpy(token.lexema, buffer);
-    token.valor_numerico = atof(buffer);
-    
-    return token;
-}
-
-/* Leer un identificador */
-Token leer_identificador(void) {
-    Token token;
-    char buffer[256];
-    int indice = 0;
-    
-    token.tipo = TOKEN_IDENTIFICADOR;
-    token.linea = linea_actual;
-    token.columna = columna_actual;
-    
-    /* Leer letras y dígitos (sin guión bajo para consistencia con Flex) */
-    while (leer_caracter() != EOF) {
-        if (isalpha(caracter_actual) || isdigit(caracter_actual)) {
-            buffer[indice++] = caracter_actual;
-        } else {
-            /* Caracter no pertenece al identificador, retroceder */
-            retroceder_caracter();
-            break;
-        }
-    }
-    
-    buffer[indice] = '\0';
-    strcpy(token.lexema, buffer);
-    token.valor_numerico = 0.0;
-    
-    return token;
-}
-
-/* Obtener el siguiente token */
-Token obtener_siguiente_token(void) {
-    Token token;
-    
-    /* Saltar espacios en blanco */
-    saltar_espacios();
-    
-    /* Leer el siguiente caracter */
-    if (leer_caracter() == EOF) {
-        token.tipo = TOKEN_EOF;
-        token.linea = linea_actual;
-        token.columna = columna_actual;
-        strcpy(token.lexema, "EOF");
-        token.valor_numerico = 0.0;
-        return token;
-    }
-    
-    /* Analizar el caracter actual */
-    token.linea = linea_actual;
-    token.columna = columna_actual;
-    
-    if (isdigit(caracter_actual)) {
-        /* Es un número, retroceder y leer completo */
-        retroceder_caracter();
-        return leer_numero();
-    }
-    
-    if (isalpha(caracter_actual)) {
-        /* Es un identificador, retroceder y leer completo */
-        retroceder_caracter();
-        return leer_identificador();
-    }
-    
-    /* Operadores y símbolos de un solo caracter */
-    switch (caracter_actual) {
-        case '+':
-            token.tipo = TOKEN_SUMA;
-            strcpy(token.lexema, "+");
-            break;
-        case '-':
-            token.tipo = TOKEN_RESTA;
-            strcpy(token.lexema, "-");
-            break;
-        case '*':
-            token.tipo = TOKEN_MULTIPLICACION;
-            strcpy(token.lexema, "*");
-            break;
-        case '/':
-            token.tipo = TOKEN_DIVISION;
-            strcpy(token.lexema, "/");
-            break;
-        case '(':
-            token.tipo = TOKEN_PARENTESIS_IZQ;
-            strcpy(token.lexema, "(");
-            break;
-        case ')':
-            token.tipo = TOKEN_PARENTESIS_DER;
-            strcpy(token.lexema, ")");
-            break;
-        case '=':
-            token.tipo = TOKEN_ASIGNACION;
-            strcpy(token.lexema, "=");
-            break;
-        case '\n':
-            token.tipo = TOKEN_FIN_LINEA;
-            strcpy(token.lexema, "\\n");
-            break;
-        default:
-            token.tipo = TOKEN_ERROR;
-            sprintf(token.lexema, "%c", caracter_actual);
-            break;
-    }
-    
-    token.valor_numerico = 0.0;
-    return token;
-}
+int resumir_archivo(const char *nombre_archivo);
 
 /* Obtener el nombre del token para imprimir */
 const char* nombre_token(TipoToken tipo) {
@@ -267,18 +41,18 @@ void imprimir_token(Token token) {
             printf(", Valor: %.2f", token.valor_numerico);
             break;
         case TOKEN_IDENTIFICADOR:
-            printf(", Nombre: %s", token.lexema);
+            printf(", Nombre: %.*s", (int)token.longitud, token.lexema);
             break;
         case TOKEN_SUMA:
         case TOKEN_RESTA:
         case TOKEN_MULTIPLICACION:
         case TOKEN_DIVISION:
         case TOKEN_ASIGNACION:
-            printf(" (%s)", token.lexema);
+            printf(" (%.*s)", (int)token.longitud, token.lexema);
             break;
         case TOKEN_ERROR:
-            printf(": Caracter no reconocido '%s' en línea %d, columna %d", 
-                   token.lexema, token.linea, token.columna);
+            printf(": Caracter no reconocido '%.*s' en línea %d, columna %d", 
+                   (int)token.longitud, token.lexema, token.linea, token.columna);
             break;
         default:
             break;
@@ -287,17 +61,107 @@ void imprimir_token(Token token) {
     printf("\n");
 }
 
+/* Leer un archivo completo en memoria */
+static char* leer_archivo(const char *nombre_archivo, size_t *longitud) {
+    int descriptor = open(nombre_archivo, O_RDONLY);
+    if (descriptor < 0) {
+        return NULL;
+    }
+    
+    char *datos = NULL;
+    size_t capacidad = 0;
+    ssize_t leidos;
+    *longitud = 0;
+    do {
+        if (*longitud == capacidad) {
+            capacidad = capacidad ? capacidad * 2 : TAMANO_BLOQUE_ENTRADA;
+            char *nuevo = (char*)realloc(datos, capacidad);
+            if (!nuevo) {
+                free(datos);
+                close(descriptor);
+                return NULL;
+            }
+            datos = nuevo;
+        }
+        leidos = read(descriptor, datos + *longitud, capacidad - *longitud);
+        if (leidos > 0) {
+            *longitud += (size_t)leidos;
+        }
+    } while (leidos > 0 || (leidos < 0 && errno == EINTR));
+    
+    close(descriptor);
+    if (leidos < 0) {
+        free(datos);
+        return NULL;
+    }
+    return datos;
+}
+
+/* Modo resumen: tokeniza el archivo de una vez con el flujo empaquetado y
+   recorre los arreglos para contar tokens por tipo, sin imprimir cada uno */
+int resumir_archivo(const char *nombre_archivo) {
+    size_t longitud;
+    char *datos = leer_archivo(nombre_archivo, &longitud);
+    if (!datos) {
+        fprintf(stderr, "Error: No se puede abrir el archivo '%s'\n", nombre_archivo);
+        return 1;
+    }
+    
+    FlujoTokens flujo;
+    flujo_iniciar(&flujo);
+    if (!flujo_tokenizar(&flujo, datos, longitud)) {
+        flujo_liberar(&flujo);
+        free(datos);
+        return 1;
+    }
+    
+    /* Recorrido secuencial de los arreglos: solo se leen 'valores' y
+       'longitudes' en los tokens que los necesitan */
+    size_t por_tipo[TOKEN_FIN_LINEA + 2] = { 0 };
+    double suma_numeros = 0.0;
+    uint32_t identificador_mas_largo = 0;
+    for (size_t i = 0; i < flujo.num_tokens; i++) {
+        int tipo = flujo.tipos[i];
+        por_tipo[tipo == TOKEN_ERROR ? TOKEN_FIN_LINEA + 1 : tipo]++;
+        if (tipo == TOKEN_NUMERO) {
+            suma_numeros += flujo.valores[i];
+        } else if (tipo == TOKEN_IDENTIFICADOR && flujo.longitudes[i] > identificador_mas_largo) {
+            identificador_mas_largo = flujo.longitudes[i];
+        }
+    }
+    
+    printf("=== RESUMEN DE TOKENS ===\n");
+    printf("Archivo: %s (%zu bytes)\n", nombre_archivo, longitud);
+    printf("Tokens: %zu\n", flujo.num_tokens);
+    for (int tipo = TOKEN_NUMERO; tipo <= TOKEN_FIN_LINEA + 1; tipo++) {
+        if (por_tipo[tipo] > 0) {
+            printf("  %-15s %zu\n", nombre_token(tipo > TOKEN_FIN_LINEA ? TOKEN_ERROR : (TipoToken)tipo), por_tipo[tipo]);
+        }
+    }
+    printf("Suma de los números: %.2f\n", suma_numeros);
+    printf("Identificador más largo: %u caracteres\n", identificador_mas_largo);
+    
+    flujo_liberar(&flujo);
+    free(datos);
+    return 0;
+}
+
 /* Función principal */
 int main(int argc, char *argv[]) {
-    FILE *archivo_entrada = stdin;
+    int descriptor = STDIN_FILENO;
+    
+    /* Resumen de un archivo con el flujo de tokens empaquetado */
+    if (argc == 3 && strcmp(argv[1], "--resumen") == 0) {
+        return resumir_archivo(argv[2]);
+    }
     
     printf("=== ANALIZADOR LEXICOGRAFICO - CALCULADORA (C PURO) ===\n");
     printf("Implementación sin Flex - Análisis caracter por caracter\n");
     
     /* Si se proporciona un archivo como argumento */
     if (argc > 1) {
-        archivo_entrada = fopen(argv[1], "r");
-        if (!archivo_entrada) {
+        descriptor = open(argv[1], O_RDONLY);
+        if (descriptor < 0) {
             fprintf(stderr, "Error: No se puede abrir el archivo '%s'\n", argv[1]);
             return 1;
         }
@@ -310,23 +174,28 @@ int main(int argc, char *argv[]) {
     printf("\n");
     
     /* Inicializar el analizador */
-    inicializar_analizador(archivo_entrada);
+    Analizador analizador;
+    if (!inicializar_analizador(&analizador, descriptor)) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el analizador\n");
+        return 1;
+    }
     
     /* Procesar tokens hasta el final del archivo */
     Token token;
     do {
-        token = obtener_siguiente_token();
+        token = obtener_siguiente_token(&analizador);
         if (token.tipo != TOKEN_EOF) {
             imprimir_token(token);
         }
     } while (token.tipo != TOKEN_EOF);
     
     printf("\n=== ANÁLISIS COMPLETADO ===\n");
-    printf("Líneas procesadas: %d\n", linea_actual - 1);
+    printf("Líneas procesadas: %d\n", analizador.linea_actual - 1);
+    liberar_analizador(&analizador);
     
     /* Cerrar archivo si no es stdin */
-    if (archivo_entrada != stdin) {
-        fclose(archivo_entrada);
+    if (descriptor != STDIN_FILENO) {
+        close(descriptor);
     }
     
     return 0;
@@ -0,0 +1,289 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "lexer.h"
+#include "dfa_calculadora.h"
+
+/* Correspondencia entre los tokens del DFA generado y TipoToken */
+static const TipoToken token_de_dfa[] = {
+    [DFA_CALC_NUMERO] = TOKEN_NUMERO,
+    [DFA_CALC_IDENTIFICADOR] = TOKEN_IDENTIFICADOR,
+    [DFA_CALC_SUMA] = TOKEN_SUMA,
+    [DFA_CALC_RESTA] = TOKEN_RESTA,
+    [DFA_CALC_MULTIPLICACION] = TOKEN_MULTIPLICACION,
+    [DFA_CALC_DIVISION] = TOKEN_DIVISION,
+    [DFA_CALC_PARENTESIS_IZQ] = TOKEN_PARENTESIS_IZQ,
+    [DFA_CALC_PARENTESIS_DER] = TOKEN_PARENTESIS_DER,
+    [DFA_CALC_ASIGNACION] = TOKEN_ASIGNACION,
+    [DFA_CALC_FIN_LINEA] = TOKEN_FIN_LINEA,
+    [DFA_CALC_ESPACIO] = TOKEN_ERROR
+};
+
+/* Valor de un número [0-9]+(\.[0-9]*)? que no termina en '\0'. Los
+   lexemas cortos se copian en la pila; los largos, en memoria dinámica */
+static double valor_numero(const char *lexema, size_t longitud) {
+    char copia_corta[64];
+    char *copia = copia_corta;
+    if (longitud >= sizeof(copia_corta)) {
+        copia = (char*)malloc(longitud + 1);
+        if (!copia) {
+            return 0.0;
+        }
+    }
+    memcpy(copia, lexema, longitud);
+    copia[longitud] = '\0';
+    double valor = strtod(copia, NULL);
+    if (copia != copia_corta) {
+        free(copia);
+    }
+    return valor;
+}
+
+/* ===== Analizador por flujo ===== */
+
+/* Inicializar el analizador lexicográfico. Devuelve 0 si falta memoria */
+int inicializar_analizador(Analizador *analizador, int descriptor) {
+    analizador->descriptor = descriptor;
+    analizador->buffer = (char*)malloc(TAMANO_BLOQUE_ENTRADA);
+    analizador->capacidad = analizador->buffer ? TAMANO_BLOQUE_ENTRADA : 0;
+    analizador->posicion = 0;
+    analizador->fin = 0;
+    analizador->inicio_token = 0;
+    analizador->en_token = 0;
+    analizador->fin_archivo = 0;
+    analizador->linea_actual = 1;
+    analizador->columna_actual = 1;
+    return analizador->buffer != NULL;
+}
+
+void liberar_analizador(Analizador *analizador) {
+    free(analizador->buffer);
+    analizador->buffer = NULL;
+    analizador->capacidad = 0;
+}
+
+/* Rellenar el buffer con el siguiente bloque de la entrada. Si hay un
+   token en curso, sus caracteres se mueven al principio del buffer para
+   que el lexema siga contiguo; el buffer se duplica si el lexema lo ocupa
+   entero. Devuelve 0 al llegar al final (o ante un error) */
+static int rellenar_buffer(Analizador *analizador) {
+    if (analizador->fin_archivo) {
+        return 0;
+    }
+
+    size_t conservar = 0;
+    if (analizador->en_token) {
+        conservar = analizador->fin - analizador->inicio_token;
+        memmove(analizador->buffer, analizador->buffer + analizador->inicio_token, conservar);
+        analizador->inicio_token = 0;
+        if (conservar == analizador->capacidad) {
+            char *nuevo = (char*)realloc(analizador->buffer, analizador->capacidad * 2);
+            if (!nuevo) {
+                fprintf(stderr, "Error: No se pudo asignar memoria para el lexema\n");
+                analizador->fin_archivo = 1;
+            } else {
+                analizador->buffer = nuevo;
+                analizador->capacidad *= 2;
+            }
+        }
+    }
+    analizador->posicion = conservar;
+    analizador->fin = conservar;
+    if (analizador->fin_archivo) {
+        return 0;
+    }
+
+    ssize_t leidos;
+    do {
+        leidos = read(analizador->descriptor, analizador->buffer + conservar, analizador->capacidad - conservar);
+    } while (leidos < 0 && errno == EINTR);
+
+    if (leidos <= 0) {
+        analizador->fin_archivo = 1;
+        return 0;
+    }
+
+    analizador->fin = conservar + (size_t)leidos;
+    return 1;
+}
+
+/* Ver el siguiente caracter sin consumirlo (lookahead de un caracter) */
+int ver_caracter(Analizador *analizador) {
+    if (analizador->posicion == analizador->fin && !rellenar_buffer(analizador)) {
+        return EOF;
+    }
+    return (unsigned char)analizador->buffer[analizador->posicion];
+}
+
+/* Consumir el caracter devuelto por ver_caracter */
+void avanzar_caracter(Analizador *analizador, int caracter) {
+    analizador->posicion++;
+    if (caracter == '\n') {
+        analizador->linea_actual++;
+        analizador->columna_actual = 1;
+    } else {
+        analizador->columna_actual++;
+    }
+}
+
+/* Saltar espacios en blanco y tabulaciones */
+void saltar_espacios(Analizador *analizador) {
+    int caracter;
+    while ((caracter = ver_caracter(analizador)) == ' ' || caracter == '\t') {
+        avanzar_caracter(analizador, caracter);
+    }
+}
+
+/* Obtener el siguiente token */
+Token obtener_siguiente_token(Analizador *analizador) {
+    Token token;
+
+    /* Saltar espacios en blanco */
+    saltar_espacios(analizador);
+
+    /* Leer el siguiente caracter */
+    int caracter = ver_caracter(analizador);
+    if (caracter == EOF) {
+        token.tipo = TOKEN_EOF;
+        token.linea = analizador->linea_actual;
+        token.columna = analizador->columna_actual;
+        token.lexema = "EOF";
+        token.longitud = 3;
+        token.valor_numerico = 0.0;
+        return token;
+    }
+    analizador->inicio_token = analizador->posicion;
+    analizador->en_token = 1;
+    avanzar_caracter(analizador, caracter);
+
+    token.linea = analizador->linea_actual;
+    token.columna = analizador->columna_actual;
+    token.valor_numerico = 0.0;
+
+    /* Avanzar por el DFA mientras haya transición (máxima coincidencia).
+       Todos los estados alcanzables son de aceptación, así que el caracter
+       que lleva al estado muerto simplemente no se consume. El recorrido se
+       hace directamente sobre el buffer y solo se rellena en su borde */
+    int estado = dfa_transicion(&DFA_CALC_TABLAS, DFA_ESTADO_INICIAL, (unsigned char)caracter);
+    if (estado == DFA_ESTADO_MUERTO) {
+        /* Caracter que no inicia ningún token */
+        token.tipo = TOKEN_ERROR;
+    } else {
+        while (!DFA_CALC_terminal[estado] && ver_caracter(analizador) != EOF) {
+            const char *cursor = analizador->buffer + analizador->posicion;
+            const char *fin = analizador->buffer + analizador->fin;
+            int detenido = 0;
+            while (cursor < fin) {
+                int siguiente = dfa_transicion(&DFA_CALC_TABLAS, estado, (unsigned char)*cursor);
+                if (siguiente == DFA_ESTADO_MUERTO) {
+                    detenido = 1;
+                    break;
+                }
+                avanzar_caracter(analizador, (unsigned char)*cursor);
+                cursor++;
+                estado = siguiente;
+                if (DFA_CALC_terminal[estado]) {
+                    break;
+                }
+            }
+            if (detenido) {
+                break;
+            }
+        }
+        token.tipo = token_de_dfa[DFA_CALC_token[estado]];
+    }
+
+    /* El lexema se toma al final: un relleno puede haber movido el buffer */
+    token.lexema = analizador->buffer + analizador->inicio_token;
+    token.longitud = analizador->posicion - analizador->inicio_token;
+    analizador->en_token = 0;
+
+    if (token.tipo == TOKEN_NUMERO) {
+        token.valor_numerico = valor_numero(token.lexema, token.longitud);
+    }
+
+    return token;
+}
+
+/* ===== Flujo de tokens empaquetado ===== */
+
+void flujo_iniciar(FlujoTokens *flujo) {
+    memset(flujo, 0, sizeof(*flujo));
+}
+
+void flujo_liberar(FlujoTokens *flujo) {
+    free(flujo->tipos);
+    free(flujo->inicios);
+    free(flujo->longitudes);
+    free(flujo->valores);
+    free(flujo->lineas);
+    flujo_iniciar(flujo);
+}
+
+/* Amplía los cinco arreglos a 'capacidad' tokens */
+static int reservar_tokens(FlujoTokens *flujo, size_t capacidad) {
+    int8_t *tipos = (int8_t*)realloc(flujo->tipos, capacidad * sizeof(int8_t));
+    if (tipos) flujo->tipos = tipos;
+    uint32_t *inicios = (uint32_t*)realloc(flujo->inicios, capacidad * sizeof(uint32_t));
+    if (inicios) flujo->inicios = inicios;
+    uint32_t *longitudes = (uint32_t*)realloc(flujo->longitudes, capacidad * sizeof(uint32_t));
+    if (longitudes) flujo->longitudes = longitudes;
+    double *valores = (double*)realloc(flujo->valores, capacidad * sizeof(double));
+    if (valores) flujo->valores = valores;
+    uint32_t *lineas = (uint32_t*)realloc(flujo->lineas, capacidad * sizeof(uint32_t));
+    if (lineas) flujo->lineas = lineas;
+
+    if (!tipos || !inicios || !longitudes || !valores || !lineas) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el flujo de tokens\n");
+        return 0;
+    }
+    flujo->capacidad = capacidad;
+    return 1;
+}
+
+int flujo_tokenizar(FlujoTokens *flujo, const char *texto, size_t longitud) {
+    flujo->texto = texto;
+    flujo->num_tokens = 0;
+    if (longitud > UINT32_MAX) {
+        fprintf(stderr, "Error: El texto supera los 4 GB que admite el flujo de tokens\n");
+        return 0;
+    }
+
+    /* Estimación inicial: un token cada 4 bytes */
+    if (flujo->capacidad == 0 && !reservar_tokens(flujo, longitud / 4 + 16)) {
+        return 0;
+    }
+
+    const unsigned char *datos = (const unsigned char*)texto;
+    size_t posicion = 0;
+    uint32_t linea = 1;
+    while (posicion < longitud) {
+        int token_dfa;
+        size_t tamano = dfa_reconocer(&DFA_CALC_TABLAS, datos + posicion, longitud - posicion, &token_dfa);
+        if (token_dfa == DFA_CALC_ESPACIO) {
+            posicion += tamano;
+            continue;
+        }
+
+        if (flujo->num_tokens == flujo->capacidad && !reservar_tokens(flujo, flujo->capacidad * 2)) {
+            return 0;
+        }
+        size_t i = flujo->num_tokens++;
+        TipoToken tipo = token_dfa < 0 ? TOKEN_ERROR : token_de_dfa[token_dfa];
+        flujo->tipos[i] = (int8_t)tipo;
+        flujo->inicios[i] = (uint32_t)posicion;
+        flujo->longitudes[i] = (uint32_t)tamano;
+        flujo->valores[i] = tipo == TOKEN_NUMERO ? valor_numero(texto + posicion, tamano) : 0.0;
+        flujo->lineas[i] = linea;
+
+        if (tipo == TOKEN_FIN_LINEA) {
+            linea++;
+        }
+        posicion += tamano;
+    }
+    return 1;
+}
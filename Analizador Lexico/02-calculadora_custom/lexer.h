@@ -0,0 +1,86 @@
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Definición de tokens */
+typedef enum {
+    TOKEN_EOF = 0,
+    TOKEN_NUMERO = 1,
+    TOKEN_SUMA = 2,
+    TOKEN_RESTA = 3,
+    TOKEN_MULTIPLICACION = 4,
+    TOKEN_DIVISION = 5,
+    TOKEN_PARENTESIS_IZQ = 6,
+    TOKEN_PARENTESIS_DER = 7,
+    TOKEN_ASIGNACION = 8,
+    TOKEN_IDENTIFICADOR = 9,
+    TOKEN_FIN_LINEA = 10,
+    TOKEN_ERROR = -1
+} TipoToken;
+
+/* Estructura para representar un token. El lexema no se copia: apunta al
+   buffer del analizador (no termina en '\0') y es válido hasta la
+   siguiente llamada a obtener_siguiente_token */
+typedef struct {
+    TipoToken tipo;
+    double valor_numerico;
+    const char *lexema;
+    size_t longitud;
+    int linea;
+    int columna;
+} Token;
+
+/* Tamaño del bloque que se lee de una vez con read() */
+#define TAMANO_BLOQUE_ENTRADA (64 * 1024)
+
+/* Estado del analizador: una ventana de la entrada que se rellena por
+   bloques. Al rellenar se conserva el token en curso, así que el buffer
+   solo crece si un lexema no cabe en él; fuera de eso la memoria usada no
+   depende del tamaño de la entrada */
+typedef struct {
+    int descriptor;
+    char *buffer;
+    size_t capacidad;
+    size_t posicion;      /* Siguiente caracter por consumir */
+    size_t fin;           /* Bytes válidos en el buffer */
+    size_t inicio_token;  /* Primer caracter del token en curso */
+    int en_token;
+    int fin_archivo;
+    int linea_actual;
+    int columna_actual;
+} Analizador;
+
+/* Analizador por flujo (lee de un descriptor) */
+int inicializar_analizador(Analizador *analizador, int descriptor);
+void liberar_analizador(Analizador *analizador);
+int ver_caracter(Analizador *analizador);
+void avanzar_caracter(Analizador *analizador, int caracter);
+void saltar_espacios(Analizador *analizador);
+Token obtener_siguiente_token(Analizador *analizador);
+
+/* Flujo de tokens empaquetado: un buffer completo tokenizado de una vez en
+   arreglos paralelos (estructura de arreglos). Los lexemas no se copian:
+   el token i es texto[inicios[i] .. inicios[i] + longitudes[i]). Los
+   espacios no generan tokens y no hay token EOF. 'lineas' es la línea en
+   la que empieza cada token; 'valores' solo tiene sentido en los números */
+typedef struct {
+    const char *texto;
+    int8_t *tipos;         /* TipoToken */
+    uint32_t *inicios;
+    uint32_t *longitudes;
+    double *valores;
+    uint32_t *lineas;
+    size_t num_tokens;
+    size_t capacidad;
+} FlujoTokens;
+
+void flujo_iniciar(FlujoTokens *flujo);
+void flujo_liberar(FlujoTokens *flujo);
+
+/* Tokeniza los 'longitud' bytes de 'texto' (hasta 4 GB), que deben seguir
+   vivos mientras se use el flujo. Devuelve 0 si falta memoria */
+int flujo_tokenizar(FlujoTokens *flujo, const char *texto, size_t longitud);
+
+#endif /* LEXER_H */
@@ -0,0 +1,196 @@
+// Generador determinista de corpus para los benchmarks de los cuatro front ends.
+// Escribe el corpus en stdout y, con -r, un resumen clave=valor con las
+// cantidades que medir usa para calcular tokens/s y nodos/s.
+//
+// Uso: generar_corpus [opciones] > corpus.txt
+//   -g expresiones|calculadora  gramática (por defecto expresiones)
+//   -l N   líneas (expresiones)             -t N   términos por línea
+//   -p N   profundidad máxima de paréntesis -m N   % de operadores * y /
+//   -i N   longitud de los identificadores  -s N   semilla
+//   -u     una sola expresión: líneas unidas con '+'
+//   -r archivo  resumen del corpus
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Generador congruencial lineal: misma semilla, mismo corpus
+typedef struct {
+    unsigned long long estado;
+} Generador;
+
+static unsigned int aleatorio(Generador *g) {
+    g->estado = g->estado * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned int)(g->estado >> 33);
+}
+
+typedef struct {
+    int calculadora;
+    long lineas;
+    int terminos;
+    int profundidad;
+    int mezcla;
+    int longitud_ident;
+    int una_expresion;
+} Opciones;
+
+// Cantidades del corpus generado
+typedef struct {
+    long lineas;
+    long tokens;
+    long nodos;
+    long bytes;
+} Resumen;
+
+static void emitir(Resumen *r, const char *texto, size_t longitud) {
+    fwrite(texto, 1, longitud, stdout);
+    r->bytes += (long)longitud;
+}
+
+static void emitir_token(Resumen *r, const char *texto, size_t longitud, int es_nodo) {
+    emitir(r, texto, longitud);
+    r->tokens++;
+    r->nodos += es_nodo;
+}
+
+// Identificador [a-zA-Z][a-zA-Z0-9]*: válido en las dos gramáticas
+static void emitir_identificador(Generador *g, Resumen *r, int longitud) {
+    static const char letras[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    static const char alfanumericos[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    char ident[256];
+    if (longitud < 1) longitud = 1;
+    if (longitud > (int)sizeof(ident)) longitud = (int)sizeof(ident);
+
+    ident[0] = letras[aleatorio(g) % (sizeof(letras) - 1)];
+    for (int k = 1; k < longitud; k++) {
+        ident[k] = alfanumericos[aleatorio(g) % (sizeof(alfanumericos) - 1)];
+    }
+    emitir_token(r, ident, (size_t)longitud, 1);
+}
+
+static void emitir_operando(Generador *g, Resumen *r, const Opciones *op) {
+    if (op->calculadora && aleatorio(g) % 2 == 0) {
+        // Cada llamada en su propia sentencia: el orden de evaluación de los
+        // argumentos no está definido y cambiaría el corpus entre compiladores
+        char numero[32];
+        int decimal = aleatorio(g) % 2;
+        unsigned int entero = aleatorio(g) % 1000;
+        unsigned int fraccion = aleatorio(g) % 100;
+        int longitud = decimal ? snprintf(numero, sizeof(numero), "%u.%u", entero, fraccion)
+                               : snprintf(numero, sizeof(numero), "%u", entero);
+        emitir_token(r, numero, (size_t)longitud, 1);
+    } else {
+        emitir_identificador(g, r, op->longitud_ident);
+    }
+}
+
+static void emitir_operador(Generador *g, Resumen *r, const Opciones *op) {
+    int multiplicativo = (int)(aleatorio(g) % 100) < op->mezcla;
+    const char *operador;
+    if (op->calculadora) {
+        int primero = aleatorio(g) % 2;
+        operador = multiplicativo ? (primero ? " * " : " / ") : (primero ? " + " : " - ");
+    } else {
+        operador = multiplicativo ? " * " : " + ";
+    }
+    emitir_token(r, operador, 3, 1);
+}
+
+// Una expresión de 'terminos' operandos; los paréntesis se abren con
+// probabilidad 1/8 mientras la profundidad sea menor que la máxima
+static void emitir_expresion(Generador *g, Resumen *r, const Opciones *op) {
+    int abiertos = 0;
+    for (int i = 0; i < op->terminos; i++) {
+        if (i > 0) {
+            emitir_operador(g, r, op);
+        }
+        while (abiertos < op->profundidad && aleatorio(g) % 8 == 0) {
+            emitir_token(r, "(", 1, 1);
+            abiertos++;
+        }
+        emitir_operando(g, r, op);
+        if (abiertos > 0 && aleatorio(g) % 4 == 0) {
+            emitir_token(r, ")", 1, 0);
+            abiertos--;
+        }
+    }
+    while (abiertos-- > 0) {
+        emitir_token(r, ")", 1, 0);
+    }
+}
+
+static void generar(Generador *g, Resumen *r, const Opciones *op) {
+    for (long linea = 0; linea < op->lineas; linea++) {
+        if (op->calculadora) {
+            // ident = expresión FIN_LINEA
+            emitir_identificador(g, r, op->longitud_ident);
+            emitir_token(r, " = ", 3, 1);
+            emitir_expresion(g, r, op);
+            emitir_token(r, "\n", 1, 0);
+        } else {
+            emitir_expresion(g, r, op);
+            if (op->una_expresion && linea + 1 < op->lineas) {
+                emitir_token(r, " +", 2, 1);
+            }
+            emitir(r, "\n", 1);
+        }
+        r->lineas++;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    Opciones op = { 0, 10000, 20, 4, 30, 6, 0 };
+    unsigned long long semilla = 42;
+    const char *archivo_resumen = NULL;
+    int opcion;
+
+    while ((opcion = getopt(argc, argv, "g:l:t:p:m:i:s:ur:")) != -1) {
+        switch (opcion) {
+            case 'g':
+                if (strcmp(optarg, "calculadora") == 0) {
+                    op.calculadora = 1;
+                } else if (strcmp(optarg, "expresiones") != 0) {
+                    fprintf(stderr, "Error: gramática desconocida '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'l': op.lineas = atol(optarg); break;
+            case 't': op.terminos = atoi(optarg); break;
+            case 'p': op.profundidad = atoi(optarg); break;
+            case 'm': op.mezcla = atoi(optarg); break;
+            case 'i': op.longitud_ident = atoi(optarg); break;
+            case 's': semilla = strtoull(optarg, NULL, 10); break;
+            case 'u': op.una_expresion = 1; break;
+            case 'r': archivo_resumen = optarg; break;
+            default:
+                fprintf(stderr, "Uso: %s [-g expresiones|calculadora] [-l lineas] [-t terminos] [-p profundidad]\n"
+                                "       [-m porcentaje_mult] [-i longitud_ident] [-s semilla] [-u] [-r resumen]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (op.terminos < 1) op.terminos = 1;
+
+    Generador g = { semilla };
+    Resumen r = { 0, 0, 0, 0 };
+    generar(&g, &r, &op);
+    if (op.calculadora) {
+        r.nodos = 0; // Los analizadores léxicos no construyen árboles
+    }
+    if (fflush(stdout) != 0) {
+        return 1;
+    }
+
+    if (archivo_resumen) {
+        FILE *archivo = fopen(archivo_resumen, "w");
+        if (!archivo) {
+            fprintf(stderr, "Error: no se pudo escribir %s\n", archivo_resumen);
+            return 1;
+        }
+        fprintf(archivo, "lineas=%ld tokens=%ld nodos=%ld bytes=%ld\n", r.lineas, r.tokens, r.nodos, r.bytes);
+        fclose(archivo);
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+// Ejecuta un front end sobre un corpus y escribe una línea clave=valor con
+// el tiempo, la memoria pico y los rendimientos derivados del resumen del
+// corpus (ver generar_corpus).
+//
+// Uso: medir -n motor -c corpus -r resumen [-e entrada] [-f marca] -- programa [args...]
+//   -e archivo  se conecta a la entrada estándar del programa
+//   -f marca    la corrida falla si la salida contiene 'marca'
+//               (sin -f la salida se descarta en /dev/null)
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+typedef struct {
+    long lineas;
+    long tokens;
+    long nodos;
+    long bytes;
+} Resumen;
+
+static int leer_resumen(const char *nombre_archivo, Resumen *r) {
+    FILE *archivo = fopen(nombre_archivo, "r");
+    if (!archivo) return 0;
+    int leidos = fscanf(archivo, "lineas=%ld tokens=%ld nodos=%ld bytes=%ld",
+                        &r->lineas, &r->tokens, &r->nodos, &r->bytes);
+    fclose(archivo);
+    return leidos == 4;
+}
+
+static double segundos_actuales(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Lee la salida del programa desde 'fd' buscando 'marca' (también entre
+// dos lecturas consecutivas)
+static int buscar_marca(int fd, const char *marca) {
+    size_t longitud_marca = strlen(marca);
+    char buffer[65536 + 256];
+    size_t arrastre = 0;
+    int encontrada = 0;
+    ssize_t leidos;
+
+    if (longitud_marca == 0 || longitud_marca > 256) return 0;
+
+    while ((leidos = read(fd, buffer + arrastre, 65536)) != 0) {
+        if (leidos < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        size_t total = arrastre + (size_t)leidos;
+        if (!encontrada) {
+            for (size_t i = 0; i + longitud_marca <= total; i++) {
+                if (memcmp(buffer + i, marca, longitud_marca) == 0) {
+                    encontrada = 1;
+                    break;
+                }
+            }
+        }
+        arrastre = longitud_marca - 1 < total ? longitud_marca - 1 : total;
+        memmove(buffer, buffer + total - arrastre, arrastre);
+    }
+    return encontrada;
+}
+
+int main(int argc, char *argv[]) {
+    const char *motor = NULL, *corpus = NULL, *archivo_resumen = NULL;
+    const char *entrada = NULL, *marca = NULL;
+    int opcion;
+
+    while ((opcion = getopt(argc, argv, "n:c:r:e:f:")) != -1) {
+        switch (opcion) {
+            case 'n': motor = optarg; break;
+            case 'c': corpus = optarg; break;
+            case 'r': archivo_resumen = optarg; break;
+            case 'e': entrada = optarg; break;
+            case 'f': marca = optarg; break;
+            default: break;
+        }
+    }
+    if (!motor || !corpus || !archivo_resumen || optind >= argc) {
+        fprintf(stderr, "Uso: %s -n motor -c corpus -r resumen [-e entrada] [-f marca] -- programa [args...]\n", argv[0]);
+        return 1;
+    }
+
+    Resumen r;
+    if (!leer_resumen(archivo_resumen, &r)) {
+        fprintf(stderr, "Error: no se pudo leer el resumen %s\n", archivo_resumen);
+        return 1;
+    }
+
+    int tuberia[2] = { -1, -1 };
+    if (marca && pipe(tuberia) != 0) {
+        perror("pipe");
+        return 1;
+    }
+
+    double inicio = segundos_actuales();
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        return 1;
+    }
+
+    if (pid == 0) {
+        int nulo = open("/dev/null", O_WRONLY);
+        if (entrada) {
+            int fd = open(entrada, O_RDONLY);
+            if (fd < 0) _exit(127);
+            dup2(fd, STDIN_FILENO);
+            close(fd);
+        }
+        if (marca) {
+            close(tuberia[0]);
+            dup2(tuberia[1], STDOUT_FILENO);
+            close(tuberia[1]);
+        } else {
+            dup2(nulo, STDOUT_FILENO);
+        }
+        dup2(nulo, STDERR_FILENO);
+        close(nulo);
+        execvp(argv[optind], &argv[optind]);
+        _exit(127);
+    }
+
+    int marca_encontrada = 0;
+    if (marca) {
+        close(tuberia[1]);
+        marca_encontrada = buscar_marca(tuberia[0], marca);
+        close(tuberia[0]);
+    }
+
+    int estado;
+    while (waitpid(pid, &estado, 0) < 0 && errno == EINTR) {
+    }
+    double segundos = segundos_actuales() - inicio;
+
+    // Solo se espera a un hijo, así que el máximo de los hijos es el suyo
+    struct rusage uso;
+    getrusage(RUSAGE_CHILDREN, &uso);
+
+    const char *resultado = "ok";
+    if (!WIFEXITED(estado) || WEXITSTATUS(estado) == 127) {
+        resultado = "no_ejecutado";
+    } else if (WEXITSTATUS(estado) != 0 || marca_encontrada) {
+        resultado = "error";
+    }
+
+    printf("motor=%s corpus=%s estado=%s bytes=%ld lineas=%ld tokens=%ld nodos=%ld "
+           "segundos=%.4f tokens_por_seg=%.0f nodos_por_seg=%.0f ns_por_expresion=%.0f "
+           "mb_por_seg=%.1f rss_pico_kb=%ld\n",
+           motor, corpus, resultado, r.bytes, r.lineas, r.tokens, r.nodos,
+           segundos, r.tokens / segundos, r.nodos / segundos,
+           r.lineas ? segundos * 1e9 / r.lineas : 0.0,
+           r.bytes / 1e6 / segundos, uso.ru_maxrss);
+    return 0;
+}
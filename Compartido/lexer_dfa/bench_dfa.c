@@ -0,0 +1,110 @@
+// Benchmark del motor DFA frente al reconocimiento con ctype + switch que
+// usaban los lexers manuales, sobre el lenguaje de la calculadora.
+// Uso: bench_dfa [megabytes] [repeticiones]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "dfa_calculadora.h"
+
+static double segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Corpus determinista de asignaciones de la calculadora
+static char* generar_corpus(size_t tamano) {
+    static const char *piezas[] = { "x", "total", "a1", "3.14", "42", "1000", " + ", " - ", " * ",
+                                    " / ", "(", ")", " = ", "\n", "  ", "\t", "variable2", "0.5" };
+    char *datos = (char*)malloc(tamano + 32);
+    size_t n = 0;
+    unsigned long long estado = 12345;
+    while (n < tamano) {
+        estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+        const char *pieza = piezas[(estado >> 33) % (sizeof(piezas) / sizeof(piezas[0]))];
+        size_t longitud = strlen(pieza);
+        memcpy(datos + n, pieza, longitud);
+        n += longitud;
+    }
+    datos[n] = '\0';
+    return datos;
+}
+
+// Versión de referencia: clasificación con ctype y switch, como los lexers originales
+static size_t reconocer_ctype(const unsigned char *p, size_t longitud, int *token) {
+    size_t i = 0;
+    if (isdigit(p[0])) {
+        int punto = 0;
+        while (i < longitud && (isdigit(p[i]) || (p[i] == '.' && !punto))) {
+            if (p[i] == '.') punto = 1;
+            i++;
+        }
+        *token = DFA_CALC_NUMERO;
+        return i;
+    }
+    if (isalpha(p[0])) {
+        while (i < longitud && (isalpha(p[i]) || isdigit(p[i]))) i++;
+        *token = DFA_CALC_IDENTIFICADOR;
+        return i;
+    }
+    if (p[0] == ' ' || p[0] == '\t') {
+        while (i < longitud && (p[i] == ' ' || p[i] == '\t')) i++;
+        *token = DFA_CALC_ESPACIO;
+        return i;
+    }
+    switch (p[0]) {
+        case '+': *token = DFA_CALC_SUMA; break;
+        case '-': *token = DFA_CALC_RESTA; break;
+        case '*': *token = DFA_CALC_MULTIPLICACION; break;
+        case '/': *token = DFA_CALC_DIVISION; break;
+        case '(': *token = DFA_CALC_PARENTESIS_IZQ; break;
+        case ')': *token = DFA_CALC_PARENTESIS_DER; break;
+        case '=': *token = DFA_CALC_ASIGNACION; break;
+        case '\n': *token = DFA_CALC_FIN_LINEA; break;
+        default: *token = -1; break;
+    }
+    return 1;
+}
+
+static size_t reconocer_dfa(const unsigned char *p, size_t longitud, int *token) {
+    return dfa_reconocer(&DFA_CALC_TABLAS, p, longitud, token);
+}
+
+static void medir(const char *nombre, size_t (*reconocer)(const unsigned char*, size_t, int*),
+                  const char *datos, size_t longitud, int repeticiones) {
+    unsigned long long tokens = 0;
+    unsigned long long control = 0;
+    double inicio = segundos();
+    for (int r = 0; r < repeticiones; r++) {
+        size_t i = 0;
+        while (i < longitud) {
+            int token;
+            size_t n = reconocer((const unsigned char*)datos + i, longitud - i, &token);
+            control = control * 31 + (unsigned long long)(token + 1) * 7 + n;
+            i += n;
+            tokens++;
+        }
+    }
+    double tiempo = segundos() - inicio;
+    printf("motor=%s bytes=%zu tokens=%llu mb_por_seg=%.1f ns_por_token=%.2f control=%llx\n",
+           nombre, longitud * repeticiones, tokens, longitud * repeticiones / 1e6 / tiempo,
+           tiempo * 1e9 / tokens, control);
+}
+
+int main(int argc, char *argv[]) {
+    size_t megabytes = argc > 1 ? (size_t)atoi(argv[1]) : 16;
+    int repeticiones = argc > 2 ? atoi(argv[2]) : 5;
+    size_t tamano = megabytes * 1024 * 1024;
+    char *datos = generar_corpus(tamano);
+
+    medir("ctype_switch", reconocer_ctype, datos, tamano, repeticiones);
+    medir("dfa_tablas", reconocer_dfa, datos, tamano, repeticiones);
+
+    free(datos);
+    return 0;
+}
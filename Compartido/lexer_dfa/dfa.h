@@ -0,0 +1,52 @@
+#ifndef DFA_H
+#define DFA_H
+
+#include <stddef.h>
+
+// Motor de autómata finito determinista dirigido por tablas.
+// Las tablas las genera generar_dfa en tiempo de compilación:
+//   clase[256]                       byte -> clase de caracteres
+//   transicion[estado * clases + c]  estado siguiente (0 = estado muerto)
+//   token[estado]                    token aceptado en el estado (-1: ninguno)
+//   terminal[estado]                 1 si desde el estado solo se llega al estado muerto
+// Las clases se calculan sobre bytes, por lo que el resultado no depende del locale.
+
+#define DFA_ESTADO_MUERTO 0
+#define DFA_ESTADO_INICIAL 1
+
+typedef struct {
+    const unsigned char *clase;
+    const unsigned char *transicion;
+    const signed char *token;
+    const unsigned char *terminal;
+    int num_clases;
+} TablasDfa;
+
+static inline int dfa_transicion(const TablasDfa *tablas, int estado, unsigned char c) {
+    return tablas->transicion[estado * tablas->num_clases + tablas->clase[c]];
+}
+
+// Reconoce el token más largo al inicio de 'datos' (máxima coincidencia).
+// Devuelve su longitud y deja en *token su tipo; si ningún prefijo es un
+// token devuelve 1 y *token = -1 (carácter no reconocido)
+static inline size_t dfa_reconocer(const TablasDfa *tablas, const unsigned char *datos,
+                                   size_t longitud, int *token) {
+    int estado = DFA_ESTADO_INICIAL;
+    size_t aceptado = 0;
+    int token_aceptado = -1;
+
+    for (size_t i = 0; i < longitud; i++) {
+        estado = dfa_transicion(tablas, estado, datos[i]);
+        if (estado == DFA_ESTADO_MUERTO) break;
+        if (tablas->token[estado] >= 0) {
+            aceptado = i + 1;
+            token_aceptado = tablas->token[estado];
+        }
+        if (tablas->terminal[estado]) break;
+    }
+
+    *token = token_aceptado;
+    return aceptado ? aceptado : 1;
+}
+
+#endif // DFA_H
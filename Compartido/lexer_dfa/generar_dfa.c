@@ -0,0 +1,210 @@
+// Generador de las tablas del lexer DFA.
+// Uso: generar_dfa <expresiones|calculadora>  (escribe la cabecera en stdout)
+//
+// Cada especificación describe un autómata sobre bytes; el generador agrupa
+// los bytes con el mismo comportamiento en clases y emite las tablas
+// compactas que consume dfa.h.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_ESTADOS 32
+#define MAX_TOKENS 16
+
+typedef struct {
+    const char *nombre;
+    const char *prefijo;
+    int num_estados;
+    int transicion[MAX_ESTADOS][256];
+    int token[MAX_ESTADOS];
+    int num_tokens;
+    const char *nombres_token[MAX_TOKENS];
+} Especificacion;
+
+static const char LETRAS[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+static const char DIGITOS[] = "0123456789";
+
+static void iniciar(Especificacion *e, const char *nombre, const char *prefijo, int num_estados) {
+    memset(e, 0, sizeof(*e));
+    e->nombre = nombre;
+    e->prefijo = prefijo;
+    e->num_estados = num_estados;
+    for (int i = 0; i < MAX_ESTADOS; i++) {
+        e->token[i] = -1;
+    }
+}
+
+static int declarar_token(Especificacion *e, const char *nombre) {
+    e->nombres_token[e->num_tokens] = nombre;
+    return e->num_tokens++;
+}
+
+// Transiciones de 'origen' a 'destino' con cada byte de 'bytes'
+static void transicion(Especificacion *e, int origen, const char *bytes, int destino) {
+    for (const unsigned char *b = (const unsigned char*)bytes; *b; b++) {
+        e->transicion[origen][*b] = destino;
+    }
+}
+
+// Estados: 0 muerto, 1 inicial
+static void especificar_expresiones(Especificacion *e) {
+    enum { INICIAL = 1, IDENT, ESPACIO, SUMA, MULT, PIZQ, PDER, NUM_ESTADOS };
+    iniciar(e, "expresiones", "DFA_EXPR", NUM_ESTADOS);
+
+    // Mismo orden que TipoToken en Parser/02-parser_custom/lexer.h
+    e->token[IDENT] = declarar_token(e, "IDENTIFICADOR");
+    e->token[SUMA] = declarar_token(e, "SUMA");
+    e->token[MULT] = declarar_token(e, "MULTIPLICACION");
+    e->token[PIZQ] = declarar_token(e, "PAREN_IZQ");
+    e->token[PDER] = declarar_token(e, "PAREN_DER");
+    e->token[ESPACIO] = declarar_token(e, "ESPACIO");
+
+    // ident: [a-zA-Z][a-zA-Z0-9_]*
+    transicion(e, INICIAL, LETRAS, IDENT);
+    transicion(e, IDENT, LETRAS, IDENT);
+    transicion(e, IDENT, DIGITOS, IDENT);
+    transicion(e, IDENT, "_", IDENT);
+    // espacios: [ \t\n]+
+    transicion(e, INICIAL, " \t\n", ESPACIO);
+    transicion(e, ESPACIO, " \t\n", ESPACIO);
+    transicion(e, INICIAL, "+", SUMA);
+    transicion(e, INICIAL, "*", MULT);
+    transicion(e, INICIAL, "(", PIZQ);
+    transicion(e, INICIAL, ")", PDER);
+}
+
+static void especificar_calculadora(Especificacion *e) {
+    enum { INICIAL = 1, ENTERO, PUNTO, DECIMAL, IDENT, ESPACIO,
+           SUMA, RESTA, MULT, DIV, PIZQ, PDER, ASIG, FIN_LINEA, NUM_ESTADOS };
+    iniciar(e, "calculadora", "DFA_CALC", NUM_ESTADOS);
+
+    e->token[ENTERO] = declarar_token(e, "NUMERO");
+    e->token[PUNTO] = e->token[ENTERO];
+    e->token[DECIMAL] = e->token[ENTERO];
+    e->token[IDENT] = declarar_token(e, "IDENTIFICADOR");
+    e->token[SUMA] = declarar_token(e, "SUMA");
+    e->token[RESTA] = declarar_token(e, "RESTA");
+    e->token[MULT] = declarar_token(e, "MULTIPLICACION");
+    e->token[DIV] = declarar_token(e, "DIVISION");
+    e->token[PIZQ] = declarar_token(e, "PARENTESIS_IZQ");
+    e->token[PDER] = declarar_token(e, "PARENTESIS_DER");
+    e->token[ASIG] = declarar_token(e, "ASIGNACION");
+    e->token[FIN_LINEA] = declarar_token(e, "FIN_LINEA");
+    e->token[ESPACIO] = declarar_token(e, "ESPACIO");
+
+    // número: [0-9]+ ( '.' [0-9]* )?  ("3." es un número, como en el lexer manual)
+    transicion(e, INICIAL, DIGITOS, ENTERO);
+    transicion(e, ENTERO, DIGITOS, ENTERO);
+    transicion(e, ENTERO, ".", PUNTO);
+    transicion(e, PUNTO, DIGITOS, DECIMAL);
+    transicion(e, DECIMAL, DIGITOS, DECIMAL);
+    // identificador: [a-zA-Z][a-zA-Z0-9]*
+    transicion(e, INICIAL, LETRAS, IDENT);
+    transicion(e, IDENT, LETRAS, IDENT);
+    transicion(e, IDENT, DIGITOS, IDENT);
+    // espacios: [ \t]+ (el salto de línea es un token)
+    transicion(e, INICIAL, " \t", ESPACIO);
+    transicion(e, ESPACIO, " \t", ESPACIO);
+    transicion(e, INICIAL, "+", SUMA);
+    transicion(e, INICIAL, "-", RESTA);
+    transicion(e, INICIAL, "*", MULT);
+    transicion(e, INICIAL, "/", DIV);
+    transicion(e, INICIAL, "(", PIZQ);
+    transicion(e, INICIAL, ")", PDER);
+    transicion(e, INICIAL, "=", ASIG);
+    transicion(e, INICIAL, "\n", FIN_LINEA);
+}
+
+// Agrupa en una clase los bytes cuyas columnas de transiciones son iguales
+static int calcular_clases(const Especificacion *e, int clase[256]) {
+    int representante[256];
+    int num_clases = 0;
+
+    for (int b = 0; b < 256; b++) {
+        clase[b] = -1;
+        for (int k = 0; k < num_clases && clase[b] < 0; k++) {
+            int igual = 1;
+            for (int s = 0; s < e->num_estados && igual; s++) {
+                igual = e->transicion[s][b] == e->transicion[s][representante[k]];
+            }
+            if (igual) clase[b] = k;
+        }
+        if (clase[b] < 0) {
+            representante[num_clases] = b;
+            clase[b] = num_clases++;
+        }
+    }
+    return num_clases;
+}
+
+static void emitir(const Especificacion *e) {
+    int clase[256];
+    int num_clases = calcular_clases(e, clase);
+    const char *p = e->prefijo;
+
+    printf("// Generado por generar_dfa (%s); no editar\n", e->nombre);
+    printf("#ifndef %s_H\n#define %s_H\n\n#include \"dfa.h\"\n\n", p, p);
+    printf("#define %s_NUM_ESTADOS %d\n#define %s_NUM_CLASES %d\n\n", p, e->num_estados, p, num_clases);
+
+    printf("enum {\n");
+    for (int t = 0; t < e->num_tokens; t++) {
+        printf("    %s_%s = %d,\n", p, e->nombres_token[t], t);
+    }
+    printf("};\n\n");
+
+    printf("static const unsigned char %s_clase[256] = {", p);
+    for (int b = 0; b < 256; b++) {
+        printf("%s%d,", b % 16 == 0 ? "\n    " : " ", clase[b]);
+    }
+    printf("\n};\n\n");
+
+    printf("static const unsigned char %s_transicion[%d] = {\n", p, e->num_estados * num_clases);
+    for (int s = 0; s < e->num_estados; s++) {
+        printf("    ");
+        for (int c = 0; c < num_clases; c++) {
+            // Cualquier byte de la clase sirve como representante
+            int b = 0;
+            while (clase[b] != c) b++;
+            printf("%d,%s", e->transicion[s][b], c + 1 < num_clases ? " " : "");
+        }
+        printf("\n");
+    }
+    printf("};\n\n");
+
+    printf("static const signed char %s_token[%d] = {", p, e->num_estados);
+    for (int s = 0; s < e->num_estados; s++) {
+        printf(" %d,", e->token[s]);
+    }
+    printf(" };\n\n");
+
+    printf("static const unsigned char %s_terminal[%d] = {", p, e->num_estados);
+    for (int s = 0; s < e->num_estados; s++) {
+        int terminal = 1;
+        for (int b = 0; b < 256 && terminal; b++) {
+            terminal = e->transicion[s][b] == 0;
+        }
+        printf(" %d,", s != 0 && terminal);
+    }
+    printf(" };\n\n");
+
+    printf("static const TablasDfa %s_TABLAS = {\n", p);
+    printf("    %s_clase, %s_transicion, %s_token, %s_terminal, %s_NUM_CLASES\n", p, p, p, p, p);
+    printf("};\n\n#endif // %s_H\n", p);
+}
+
+int main(int argc, char *argv[]) {
+    static Especificacion especificacion;
+
+    if (argc == 2 && strcmp(argv[1], "expresiones") == 0) {
+        especificar_expresiones(&especificacion);
+    } else if (argc == 2 && strcmp(argv[1], "calculadora") == 0) {
+        especificar_calculadora(&especificacion);
+    } else {
+        fprintf(stderr, "Uso: %s <expresiones|calculadora>\n", argv[0]);
+        return 1;
+    }
+
+    emitir(&especificacion);
+    return 0;
+}
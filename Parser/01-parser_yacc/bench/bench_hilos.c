@@ -0,0 +1,72 @@
+// Benchmark: escalado del parser reentrante con 1..N hilos sobre el mismo
+// corpus (una expresión por entrada). Todas las corridas deben encontrar la
+// misma cantidad de entradas válidas. También informa las reservas de
+// memoria dinámica por línea que cuenta ContextoAnalisis.
+// Uso: bench_hilos [entradas] [hilos_max]
+
+#include <unistd.h>
+#include "parser.tab.h"
+#include "paralelo.h"
+#include "bench_util.h"
+
+int main(int argc, char *argv[]) {
+    size_t entradas = argc > 1 ? (size_t)atol(argv[1]) : 200000;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int hilos_max = argc > 2 ? atoi(argv[2]) : (cpus > 4 ? (int)cpus : 4);
+
+    // Expresiones cortas de 1 a 12 términos; una de cada 20 con un error.
+    // Se generan seguidas en un solo texto y cada entrada es una vista
+    GeneradorBench g = { 31 };
+    TextoBench corpus = { NULL, 0, 0 };
+    const char **textos = (const char**)malloc((entradas ? entradas : 1) * sizeof(char*));
+    size_t *longitudes = (size_t*)malloc((entradas ? entradas : 1) * sizeof(size_t));
+    size_t *inicios = (size_t*)malloc((entradas ? entradas : 1) * sizeof(size_t));
+    ResultadoEntrada *resultados = (ResultadoEntrada*)calloc(entradas ? entradas : 1, sizeof(ResultadoEntrada));
+    if (!textos || !longitudes || !inicios || !resultados) {
+        fprintf(stderr, "Error: sin memoria para el corpus\n");
+        return 1;
+    }
+    for (size_t i = 0; i < entradas; i++) {
+        inicios[i] = corpus.longitud;
+        bench_generar_expresion(&g, &corpus, 1 + (int)(bench_aleatorio(&g) % 12), 2, 2);
+        if (bench_aleatorio(&g) % 20 == 0) {
+            bench_agregar(&corpus, " * )", 4);
+        }
+        longitudes[i] = corpus.longitud - inicios[i];
+    }
+    // El texto ya no se mueve: las vistas se toman al final
+    for (size_t i = 0; i < entradas; i++) {
+        textos[i] = corpus.datos + inicios[i];
+    }
+
+    double segundos_base = 0;
+    long validas_base = -1;
+    for (int hilos = 1; hilos <= hilos_max; hilos++) {
+        double inicio = bench_segundos();
+        long validas = analizar_en_paralelo(textos, longitudes, entradas, hilos, 0, resultados);
+        double segundos = bench_segundos() - inicio;
+
+        if (validas_base < 0) {
+            validas_base = validas;
+            segundos_base = segundos;
+        } else if (validas != validas_base) {
+            fprintf(stderr, "Error: %d hilos encontraron %ld válidas y 1 hilo %ld\n", hilos, validas, validas_base);
+            return 1;
+        }
+        size_t reservas = 0;
+        for (size_t i = 0; i < entradas; i++) {
+            reservas += resultados[i].reservas;
+        }
+        printf("caso=hilos_%d entradas=%zu validas=%ld ms=%.1f lineas_por_s=%.0f aceleracion=%.2f "
+               "reservas_por_linea=%.2f\n", hilos, entradas, validas, segundos * 1e3, entradas / segundos,
+               segundos_base / segundos, (double)reservas / entradas);
+    }
+
+    printf("cpus=%ld\n", cpus);
+    free(resultados);
+    free(longitudes);
+    free(inicios);
+    free(textos);
+    free(corpus.datos);
+    return 0;
+}
@@ -0,0 +1,107 @@
+// Benchmark: una expresión por línea con el parser de Bison, analizando
+// cada línea por separado (un escáner por línea) frente a una sola pasada
+// de analizar_lineas. El corpus es el mismo de bench_sentencias en
+// 02-parser_custom (mismo generador y semilla), así que los números se
+// pueden comparar. Al final analiza una suma muy larga, que con la
+// gramática recursiva por la derecha agotaba YYMAXDEPTH.
+// Uso: bench_lineas [lineas] [terminos_suma_larga]
+
+#include "parser.tab.h"
+#include "bench_util.h"
+
+// Cuenta las líneas válidas de analizar_lineas
+static void contar_linea(void *datos, int linea, Nodo *arbol, const char *diagnosticos) {
+    (void)linea;
+    (void)diagnosticos;
+    if (arbol) {
+        (*(long*)datos)++;
+    }
+}
+
+// Analiza cada línea con analizar_texto; devuelve las líneas con error
+static long por_lineas(const TextoBench *corpus, long *validas, size_t *reservas) {
+    long errores = 0;
+    *validas = 0;
+    *reservas = 0;
+
+    const char *cursor = corpus->datos;
+    const char *fin = corpus->datos + corpus->longitud;
+    while (cursor < fin) {
+        const char *salto = memchr(cursor, '\n', (size_t)(fin - cursor));
+        ContextoAnalisis contexto;
+        if (analizar_texto(cursor, (size_t)(salto - cursor), &contexto) == 0) {
+            (*validas)++;
+        } else {
+            errores++;
+        }
+        *reservas += contexto.reservas;
+        contexto_liberar(&contexto);
+        cursor = salto + 1;
+    }
+    return errores;
+}
+
+int main(int argc, char *argv[]) {
+    long lineas = argc > 1 ? atol(argv[1]) : 500000;
+    int terminos_suma = argc > 2 ? atoi(argv[2]) : 200000;
+    GeneradorBench g = { 29 };
+
+    // Expresiones cortas de 1 a 12 términos; una de cada 20 con un error
+    TextoBench corpus = { NULL, 0, 0 };
+    for (long i = 0; i < lineas; i++) {
+        bench_generar_expresion(&g, &corpus, 1 + (int)(bench_aleatorio(&g) % 12), 2, 2);
+        if (bench_aleatorio(&g) % 20 == 0) {
+            bench_agregar(&corpus, " * )", 4);
+        }
+        bench_agregar(&corpus, "\n", 1);
+    }
+
+    long validas_lineas, validas_flujo = 0;
+    size_t reservas_lineas;
+    double inicio = bench_segundos();
+    long errores_lineas = por_lineas(&corpus, &validas_lineas, &reservas_lineas);
+    double segundos_lineas = bench_segundos() - inicio;
+
+    FILE *flujo = fmemopen(corpus.datos, corpus.longitud, "r");
+    if (!flujo) {
+        fprintf(stderr, "Error: No se pudo abrir el corpus como flujo\n");
+        return 1;
+    }
+    ContextoAnalisis contexto;
+    inicio = bench_segundos();
+    long errores_flujo = analizar_lineas(flujo, &contexto, contar_linea, &validas_flujo);
+    double segundos_flujo = bench_segundos() - inicio;
+    long lineas_flujo = contexto.lineas;
+    size_t reservas_flujo = contexto.reservas;
+    contexto_liberar(&contexto);
+    fclose(flujo);
+
+    if (errores_lineas != errores_flujo || validas_lineas != validas_flujo || lineas_flujo != lineas) {
+        fprintf(stderr, "Error: los modos no coinciden (%ld y %ld errores, %ld líneas)\n",
+                errores_lineas, errores_flujo, lineas_flujo);
+        return 1;
+    }
+
+    double mb = corpus.longitud / 1e6;
+    printf("caso=texto_por_linea lineas=%ld errores=%ld ms=%.1f mb_por_s=%.1f reservas=%zu\n", lineas,
+           errores_lineas, segundos_lineas * 1e3, mb / segundos_lineas, reservas_lineas);
+    printf("caso=flujo_una_pasada lineas=%ld errores=%ld ms=%.1f mb_por_s=%.1f reservas=%zu aceleracion=%.2f\n",
+           lineas, errores_flujo, segundos_flujo * 1e3, mb / segundos_flujo, reservas_flujo,
+           segundos_lineas / segundos_flujo);
+
+    // Una sola suma de muchos términos: la pila de Bison no debe crecer
+    TextoBench suma = { NULL, 0, 0 };
+    for (int i = 0; i < terminos_suma; i++) {
+        bench_agregar(&suma, i > 0 ? " + a" : "a", i > 0 ? 4 : 1);
+    }
+    inicio = bench_segundos();
+    int resultado = analizar_texto(suma.datos, suma.longitud, &contexto);
+    double segundos_suma = bench_segundos() - inicio;
+    printf("caso=suma_larga terminos=%d valida=%d ms=%.1f reservas=%zu\n", terminos_suma, resultado == 0,
+           segundos_suma * 1e3, contexto.reservas);
+    contexto_liberar(&contexto);
+
+    free(suma.datos);
+    free(corpus.datos);
+    return resultado == 0 ? 0 : 1;
+}
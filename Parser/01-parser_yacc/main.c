@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "parser.tab.h"
+#include "paralelo.h"
+
+// Analiza toda la entrada estándar como una sola expresión
+static int modo_entrada_estandar(void) {
+    printf("=== PARSER LL(1) CON LEX/YACC ===\n");
+    printf("Gramática:\n");
+    printf("E  -> T E'\n");
+    printf("E' -> + T E' | ε\n");
+    printf("T  -> F T'\n");
+    printf("T' -> * F T' | ε\n");
+    printf("F  -> ( E ) | ident\n\n");
+    
+    printf("Ingrese una expresión (Ctrl+D para terminar):\n");
+    fflush(stdout);
+    
+    ContextoAnalisis contexto;
+    int resultado = analizar_archivo(stdin, &contexto);
+    fputs(contexto.diagnosticos, stdout);
+    if (resultado == 0) {
+        printf("\n=== ANÁLISIS SINTÁCTICO EXITOSO ===\n");
+        printf("Árbol de análisis sintáctico:\n");
+        imprimir_arbol(stdout, contexto.raiz, 0);
+    } else {
+        printf("\n=== ERROR EN EL ANÁLISIS SINTÁCTICO ===\n");
+    }
+    contexto_liberar(&contexto);
+    
+    return 0;
+}
+
+// Imprime el resultado de una línea en el modo de flujo
+static void imprimir_linea(void *datos, int linea, Nodo *arbol, const char *diagnosticos) {
+    (void)datos;
+    printf("🔍 Línea %d\n", linea);
+    fputs(diagnosticos, stdout);
+    if (arbol) {
+        printf("\n=== ANÁLISIS SINTÁCTICO EXITOSO ===\n");
+        printf("Árbol de análisis sintáctico:\n");
+        imprimir_arbol(stdout, arbol, 0);
+    } else {
+        printf("\n=== ERROR EN EL ANÁLISIS SINTÁCTICO ===\n");
+    }
+    printf("----------------------------------------\n");
+}
+
+// Una expresión por línea leída como flujo (archivo o entrada estándar)
+static int modo_lineas(const char *nombre_archivo) {
+    FILE *archivo = stdin;
+    if (nombre_archivo) {
+        archivo = fopen(nombre_archivo, "r");
+        if (!archivo) {
+            printf("❌ Error: No se pudo abrir el archivo '%s'\n", nombre_archivo);
+            return 1;
+        }
+    }
+
+    ContextoAnalisis contexto;
+    long errores = analizar_lineas(archivo, &contexto, imprimir_linea, NULL);
+    if (errores < 0) {
+        fputs(contexto.diagnosticos, stdout);
+    } else {
+        fflush(stdout);
+        fprintf(stderr, "📊 %ld líneas (%ld con error)\n", contexto.lineas, errores);
+    }
+    contexto_liberar(&contexto);
+
+    if (archivo != stdin) {
+        fclose(archivo);
+    }
+    return errores < 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return modo_entrada_estandar();
+    } else if (argc == 4 && strcmp(argv[1], "-j") == 0) {
+        // Una expresión por línea, analizadas en paralelo (0: un hilo por CPU)
+        return procesar_archivo_paralelo(argv[3], atoi(argv[2]));
+    } else if ((argc == 2 || argc == 3) && strcmp(argv[1], "-l") == 0) {
+        return modo_lineas(argc == 3 ? argv[2] : NULL);
+    }
+    
+    printf("Uso:\n");
+    printf("  %s                  # Analizar la entrada estándar\n", argv[0]);
+    printf("  %s -j N <archivo>   # Una expresión por línea con N hilos (0: uno por CPU)\n", argv[0]);
+    printf("  %s -l [archivo]     # Una expresión por línea en una sola pasada (flujo)\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,239 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "parser.tab.h"
+#include "paralelo.h"
+
+// Entradas que toma un hilo cada vez que pide trabajo
+#define ENTRADAS_POR_TURNO 32
+
+// Estado compartido por los hilos: solo el índice de la siguiente entrada
+typedef struct {
+    const char *const *textos;
+    const size_t *longitudes;
+    size_t num_entradas;
+    int formatear;
+    ResultadoEntrada *resultados;
+    size_t siguiente;
+    long validas;
+    pthread_mutex_t mutex;
+} TrabajoParalelo;
+
+// Analiza una entrada con un contexto propio y guarda su resultado
+static int analizar_entrada(const char *texto, size_t longitud, int formatear, ResultadoEntrada *resultado) {
+    ContextoAnalisis contexto;
+    int valida = analizar_texto(texto, longitud, &contexto) == 0;
+    resultado->valida = valida;
+    resultado->reservas = contexto.reservas;
+    resultado->salida = NULL;
+    resultado->longitud_salida = 0;
+
+    if (formatear) {
+        FILE *destino = open_memstream(&resultado->salida, &resultado->longitud_salida);
+        if (destino) {
+            fputs(contexto.diagnosticos, destino);
+            if (valida) {
+                fprintf(destino, "\n=== ANÁLISIS SINTÁCTICO EXITOSO ===\n");
+                fprintf(destino, "Árbol de análisis sintáctico:\n");
+                imprimir_arbol(destino, contexto.raiz, 0);
+            } else {
+                fprintf(destino, "\n=== ERROR EN EL ANÁLISIS SINTÁCTICO ===\n");
+            }
+            fclose(destino);
+        }
+    }
+
+    contexto_liberar(&contexto);
+    return valida;
+}
+
+static void* ejecutar_hilo(void *argumento) {
+    TrabajoParalelo *trabajo = (TrabajoParalelo*)argumento;
+    long validas = 0;
+
+    while (1) {
+        pthread_mutex_lock(&trabajo->mutex);
+        size_t inicio = trabajo->siguiente;
+        trabajo->siguiente += ENTRADAS_POR_TURNO;
+        pthread_mutex_unlock(&trabajo->mutex);
+        if (inicio >= trabajo->num_entradas) {
+            break;
+        }
+
+        size_t fin = inicio + ENTRADAS_POR_TURNO;
+        if (fin > trabajo->num_entradas) {
+            fin = trabajo->num_entradas;
+        }
+        for (size_t i = inicio; i < fin; i++) {
+            validas += analizar_entrada(trabajo->textos[i], trabajo->longitudes[i], trabajo->formatear,
+                                        &trabajo->resultados[i]);
+        }
+    }
+
+    pthread_mutex_lock(&trabajo->mutex);
+    trabajo->validas += validas;
+    pthread_mutex_unlock(&trabajo->mutex);
+    return NULL;
+}
+
+long analizar_en_paralelo(const char *const *textos, const size_t *longitudes, size_t num_entradas,
+                          int hilos, int formatear, ResultadoEntrada *resultados) {
+    if (hilos <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        hilos = cpus > 0 ? (int)cpus : 1;
+    }
+
+    TrabajoParalelo trabajo;
+    trabajo.textos = textos;
+    trabajo.longitudes = longitudes;
+    trabajo.num_entradas = num_entradas;
+    trabajo.formatear = formatear;
+    trabajo.resultados = resultados;
+    trabajo.siguiente = 0;
+    trabajo.validas = 0;
+    pthread_mutex_init(&trabajo.mutex, NULL);
+
+    // El hilo que llama también trabaja; si no se puede crear un hilo, los
+    // demás se reparten su parte
+    pthread_t *ids = (pthread_t*)malloc((size_t)hilos * sizeof(pthread_t));
+    int creados = 0;
+    for (int i = 1; ids && i < hilos; i++) {
+        if (pthread_create(&ids[creados], NULL, ejecutar_hilo, &trabajo) == 0) {
+            creados++;
+        }
+    }
+    ejecutar_hilo(&trabajo);
+    for (int i = 0; i < creados; i++) {
+        pthread_join(ids[i], NULL);
+    }
+
+    free(ids);
+    pthread_mutex_destroy(&trabajo.mutex);
+    return trabajo.validas;
+}
+
+void liberar_resultados(ResultadoEntrada *resultados, size_t num_entradas) {
+    for (size_t i = 0; i < num_entradas; i++) {
+        free(resultados[i].salida);
+        resultados[i].salida = NULL;
+    }
+}
+
+// Lee el archivo completo en memoria (terminado en '\0')
+static char* leer_archivo(const char *nombre_archivo, size_t *longitud) {
+    FILE *archivo = fopen(nombre_archivo, "rb");
+    if (!archivo) {
+        return NULL;
+    }
+
+    size_t capacidad = 1 << 16;
+    char *datos = (char*)malloc(capacidad);
+    *longitud = 0;
+    while (datos) {
+        *longitud += fread(datos + *longitud, 1, capacidad - *longitud - 1, archivo);
+        if (*longitud < capacidad - 1) {
+            break;
+        }
+        capacidad *= 2;
+        char *nuevo = (char*)realloc(datos, capacidad);
+        if (!nuevo) {
+            free(datos);
+            datos = NULL;
+        } else {
+            datos = nuevo;
+        }
+    }
+    fclose(archivo);
+    if (datos) {
+        datos[*longitud] = '\0';
+    }
+    return datos;
+}
+
+int procesar_archivo_paralelo(const char *nombre_archivo, int hilos) {
+    size_t longitud;
+    char *datos = leer_archivo(nombre_archivo, &longitud);
+    if (!datos) {
+        printf("❌ Error: No se pudo abrir el archivo '%s'\n", nombre_archivo);
+        return 1;
+    }
+
+    // Las líneas se analizan como vistas sobre el contenido del archivo
+    size_t capacidad = 1024, num_entradas = 0;
+    const char **textos = (const char**)malloc(capacidad * sizeof(char*));
+    size_t *longitudes = (size_t*)malloc(capacidad * sizeof(size_t));
+    int *lineas = (int*)malloc(capacidad * sizeof(int));
+    int numero_linea = 1;
+    int sin_memoria = !textos || !longitudes || !lineas;
+    for (char *cursor = datos; !sin_memoria && cursor < datos + longitud; numero_linea++) {
+        char *salto = memchr(cursor, '\n', (size_t)(datos + longitud - cursor));
+        char *fin = salto ? salto : datos + longitud;
+        if (fin > cursor && cursor[0] != '#') {
+            if (num_entradas == capacidad) {
+                // Cada arreglo se reemplaza solo si su realloc funcionó, así
+                // ninguno se pierde; la capacidad cambia cuando crecen los tres
+                size_t nueva_capacidad = capacidad * 2;
+                const char **nuevos_textos = (const char**)realloc(textos, nueva_capacidad * sizeof(char*));
+                if (nuevos_textos) textos = nuevos_textos;
+                size_t *nuevas_longitudes = nuevos_textos ?
+                    (size_t*)realloc(longitudes, nueva_capacidad * sizeof(size_t)) : NULL;
+                if (nuevas_longitudes) longitudes = nuevas_longitudes;
+                int *nuevas_lineas = nuevas_longitudes ? (int*)realloc(lineas, nueva_capacidad * sizeof(int)) : NULL;
+                if (!nuevas_lineas) {
+                    sin_memoria = 1;
+                    break;
+                }
+                lineas = nuevas_lineas;
+                capacidad = nueva_capacidad;
+            }
+            textos[num_entradas] = cursor;
+            longitudes[num_entradas] = (size_t)(fin - cursor);
+            lineas[num_entradas] = numero_linea;
+            num_entradas++;
+        }
+        cursor = fin + 1;
+    }
+
+    ResultadoEntrada *resultados = sin_memoria ? NULL :
+        (ResultadoEntrada*)calloc(num_entradas ? num_entradas : 1, sizeof(ResultadoEntrada));
+    if (!resultados) {
+        printf("❌ Error: No hay memoria para analizar '%s'\n", nombre_archivo);
+        free(textos);
+        free(longitudes);
+        free(lineas);
+        free(datos);
+        return 1;
+    }
+
+    long validas = analizar_en_paralelo(textos, longitudes, num_entradas, hilos, 1, resultados);
+
+    for (size_t i = 0; i < num_entradas; i++) {
+        printf("🔍 Línea %d: %.*s\n", lineas[i], (int)longitudes[i], textos[i]);
+        if (resultados[i].salida) {
+            fwrite(resultados[i].salida, 1, resultados[i].longitud_salida, stdout);
+        }
+        printf("----------------------------------------\n");
+    }
+    fflush(stdout);
+
+    // Las estadísticas van a stderr para no alterar la salida del análisis;
+    // los tiempos por cantidad de hilos los mide bench_hilos
+    size_t reservas = 0;
+    for (size_t i = 0; i < num_entradas; i++) {
+        reservas += resultados[i].reservas;
+    }
+    fprintf(stderr, "📊 %zu líneas (%ld válidas), %zu reservas de memoria en el análisis\n",
+            num_entradas, validas, reservas);
+
+    liberar_resultados(resultados, num_entradas);
+    free(resultados);
+    free(textos);
+    free(longitudes);
+    free(lineas);
+    free(datos);
+    return 0;
+}
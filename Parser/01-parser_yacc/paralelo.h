@@ -0,0 +1,30 @@
+#ifndef PARALELO_H
+#define PARALELO_H
+
+#include <stddef.h>
+
+// Análisis de muchas entradas en paralelo. Cada entrada tiene su propio
+// escáner y su propio ContextoAnalisis, así que los hilos no comparten estado
+
+// Resultado de una entrada: si es válida, cuántas reservas de memoria
+// dinámica hizo su análisis y, al formatear, el texto que se imprimiría para
+// ella (árbol o errores)
+typedef struct {
+    int valida;
+    size_t reservas;
+    char *salida;
+    size_t longitud_salida;
+} ResultadoEntrada;
+
+// Analiza 'num_entradas' textos con 'hilos' hilos (0: uno por CPU) y
+// devuelve cuántos son válidos. Con 'formatear' cada resultado recibe su
+// salida, que se libera con liberar_resultados
+long analizar_en_paralelo(const char *const *textos, const size_t *longitudes, size_t num_entradas,
+                          int hilos, int formatear, ResultadoEntrada *resultados);
+void liberar_resultados(ResultadoEntrada *resultados, size_t num_entradas);
+
+// Analiza cada línea de un archivo (sin las vacías ni los comentarios '#')
+// e imprime los resultados en el orden del archivo. Devuelve 0 si se pudo leer
+int procesar_archivo_paralelo(const char *nombre_archivo, int hilos);
+
+#endif // PARALELO_H
@@ -1,145 +1,402 @@
-%{
+%code top {
+#define _POSIX_C_SOURCE 200809L
+}
+
+%code requires {
 #include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
+#include <stddef.h>
+
+// Escáner reentrante de Flex (lexer.l); el mismo typedef que genera Flex
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
+#endif
 
-extern int yylex();
-extern void yyerror(const char *mensaje);
-extern int linea, columna;
+// Tipo de cada nodo: la producción que lo creó
+typedef enum {
+    NODO_E,
+    NODO_E_PRIMA,
+    NODO_T,
+    NODO_T_PRIMA,
+    NODO_F
+} TipoNodo;
 
-// Estructura para el árbol sintáctico
+// Estructura para el árbol sintáctico. 'valor' es un operador constante
+// ("+", "*", "()") o un identificador copiado en la arena del análisis
 typedef struct nodo {
-    char *tipo;
-    char *valor;
+    TipoNodo tipo;
+    const char *valor;
     struct nodo *izquierdo;
     struct nodo *derecho;
 } Nodo;
 
-Nodo* crear_nodo(char *tipo, char *valor, Nodo *izq, Nodo *der);
-void imprimir_arbol(Nodo *nodo, int nivel);
-void liberar_arbol(Nodo *nodo);
+// Serie de sumas o productos en construcción: la raíz y el último nodo
+// operador, cuyo hijo derecho es el último término agregado
+typedef struct {
+    Nodo *raiz;
+    Nodo *ultimo;
+} SerieNodos;
+
+// Se llama al terminar cada línea en analizar_lineas: el árbol (NULL si la
+// línea tiene errores) y los diagnósticos solo valen durante la llamada
+typedef void (*FuncionLinea)(void *datos, int linea, Nodo *arbol, const char *diagnosticos);
 
-Nodo *raiz_arbol = NULL;
-%}
+#define CONTEXTO_DIAGNOSTICOS 512
+#define CONTEXTO_ARENA 4096
+
+// Bloque extra de la arena, cuando el bloque inicial del contexto se llena
+typedef struct BloqueArena {
+    struct BloqueArena *siguiente;
+    size_t capacidad;
+    size_t usado;
+    unsigned char datos[];
+} BloqueArena;
+
+// Estado de un análisis: la posición del escáner, el árbol y los mensajes
+// de error. Cada análisis tiene el suyo, así que varios pueden correr a la
+// vez en hilos distintos
+typedef struct {
+    int linea;
+    int columna;
+    Nodo *raiz;
+    int errores;
+    // Mensajes de error, uno por línea. Apunta a diagnosticos_inicial hasta
+    // que no caben; entonces pasa a un bloque del heap que crece al doble
+    char *diagnosticos;
+    size_t longitud_diagnosticos;
+    size_t capacidad_diagnosticos;
+    char diagnosticos_inicial[CONTEXTO_DIAGNOSTICOS];
+
+    // Arena de los nodos e identificadores: se libera entera en
+    // contexto_liberar. El primer bloque va dentro del contexto, así que una
+    // expresión normal no pide memoria dinámica para su árbol
+    BloqueArena *bloques;
+    size_t usado_inicial;
+    union {
+        unsigned char datos[CONTEXTO_ARENA];
+        void *alinear;
+    } arena_inicial;
+
+    size_t reservas;  // Llamadas a malloc/realloc del escáner, la pila y la arena
+
+    // Modo de una expresión por línea (analizar_lineas)
+    int token_inicial;        // Primer token que entrega el escáner (0: ninguno)
+    int fin_emitido;          // El escáner ya cerró la última línea
+    int salto_pendiente;      // Falta avanzar 'linea' por el último FIN_LINEA
+    FuncionLinea al_terminar_linea;
+    void *datos_linea;
+    long lineas;
+    long lineas_con_error;
+} ContextoAnalisis;
+}
+
+%code provides {
+// Funciones del análisis (el escáner y estas dos están en lexer.l).
+// Devuelven 0 si la entrada es válida; el árbol queda en contexto->raiz y
+// los errores en contexto->diagnosticos
+int analizar_texto(const char *texto, size_t longitud, ContextoAnalisis *contexto);
+int analizar_archivo(FILE *archivo, ContextoAnalisis *contexto);
+
+// Analiza una expresión por línea en una sola pasada, con un solo escáner y
+// memoria acotada, sin importar el tamaño de la entrada. Las líneas vacías y
+// las que empiezan con '#' se omiten; un error solo descarta su línea.
+// Devuelve las líneas con error (en contexto->lineas quedan las analizadas)
+long analizar_lineas(FILE *archivo, ContextoAnalisis *contexto, FuncionLinea funcion, void *datos);
+
+void contexto_iniciar(ContextoAnalisis *contexto);
+void contexto_liberar(ContextoAnalisis *contexto);
+void contexto_diagnostico(ContextoAnalisis *contexto, const char *formato, ...);
+
+// Memoria de la arena del contexto (alineada a puntero)
+void* contexto_asignar(ContextoAnalisis *contexto, size_t tamano);
+char* contexto_copiar_cadena(ContextoAnalisis *contexto, const char *cadena, size_t longitud);
+
+Nodo* crear_nodo(ContextoAnalisis *contexto, TipoNodo tipo, const char *valor, Nodo *izq, Nodo *der);
+SerieNodos extender_serie(ContextoAnalisis *contexto, SerieNodos serie, TipoNodo tipo_raiz,
+                          TipoNodo tipo_interno, const char *operador, Nodo *termino);
+const char* nombre_tipo(TipoNodo tipo);
+void imprimir_arbol(FILE *destino, Nodo *nodo, int nivel);
+}
+
+%code {
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+int yylex(YYSTYPE *yylval, yyscan_t escaner);
+void yyerror(yyscan_t escaner, ContextoAnalisis *contexto, const char *mensaje);
+static void terminar_linea(ContextoAnalisis *contexto, int linea, Nodo *arbol);
+
+// La pila de Bison solo pide memoria al superar YYINITDEPTH; se cuenta con
+// el resto de las reservas del análisis (la macro se expande dentro de
+// yyparse, donde 'contexto' es un parámetro)
+#define YYMALLOC(tamano) (contexto->reservas++, malloc(tamano))
+#define YYFREE free
+}
+
+%define api.pure full
+%lex-param {yyscan_t escaner}
+%parse-param {yyscan_t escaner} {ContextoAnalisis *contexto}
 
 %union {
-    char *cadena;
+    const char *cadena;
     struct nodo *nodo;
+    SerieNodos serie;
+    int entero;
 }
 
 %token <cadena> IDENTIFICADOR
 %token SUMA MULTIPLICACION PAREN_IZQ PAREN_DER
+%token INICIO_LINEAS           // Lo entrega primero el escáner en analizar_lineas
+%token <entero> FIN_LINEA      // Número de la línea que termina
+
+%type <nodo> E T F
+%type <serie> suma producto
 
-%type <nodo> E E_prima T T_prima F
+// Nodos e identificadores viven en la arena del contexto: no hace falta
+// %destructor, lo que quede en la pila tras un error se libera con ella
 
-%start E
+%start inicio
 
 %%
 
-E : T E_prima {
-        if ($2 != NULL) {
-            $$ = crear_nodo("E", "+", $1, $2);
-        } else {
-            $$ = $1;
-        }
-        raiz_arbol = $$;
-    }
-  ;
+// Un análisis normal es una sola expresión; analizar_lineas antepone
+// INICIO_LINEAS y entonces la entrada es una expresión por línea
+inicio : entrada
+       | INICIO_LINEAS lineas
+       ;
 
-E_prima : SUMA T E_prima {
-            if ($3 != NULL) {
-                $$ = crear_nodo("E'", "+", $2, $3);
-            } else {
-                $$ = $2;
-            }
-        }
-        | /* epsilon */ { $$ = NULL; }
+// El árbol solo se entrega al reducir la expresión completa
+entrada : E { contexto->raiz = $1; }
         ;
 
-T : F T_prima {
-        if ($2 != NULL) {
-            $$ = crear_nodo("T", "*", $1, $2);
-        } else {
-            $$ = $1;
-        }
-    }
+lineas : %empty
+       | lineas linea
+       ;
+
+// Tras un error se descarta hasta el fin de línea y se sigue con la próxima
+linea : FIN_LINEA                 { }
+      | E FIN_LINEA               { terminar_linea(contexto, $2, $1); }
+      | error FIN_LINEA           { yyerrok; terminar_linea(contexto, $2, NULL); }
+      ;
+
+// Las mismas producciones que E -> T E' y T -> F T', pero con recursión por
+// la izquierda: cada término se reduce en cuanto llega, así que la pila no
+// crece con la longitud de la serie. extender_serie arma el mismo árbol
+// anidado a la derecha que la gramática LL(1)
+E : suma { $$ = $1.raiz; }
   ;
 
-T_prima : MULTIPLICACION F T_prima {
-            if ($3 != NULL) {
-                $$ = crear_nodo("T'", "*", $2, $3);
-            } else {
-                $$ = $2;
-            }
-        }
-        | /* epsilon */ { $$ = NULL; }
-        ;
+suma : T                { $$.raiz = $1; $$.ultimo = NULL; }
+     | suma SUMA T      { $$ = extender_serie(contexto, $1, NODO_E, NODO_E_PRIMA, "+", $3); }
+     ;
+
+T : producto { $$ = $1.raiz; }
+  ;
+
+producto : F                         { $$.raiz = $1; $$.ultimo = NULL; }
+         | producto MULTIPLICACION F { $$ = extender_serie(contexto, $1, NODO_T, NODO_T_PRIMA, "*", $3); }
+         ;
 
 F : PAREN_IZQ E PAREN_DER {
-        $$ = crear_nodo("F", "()", $2, NULL);
+        $$ = crear_nodo(contexto, NODO_F, "()", $2, NULL);
     }
   | IDENTIFICADOR {
-        $$ = crear_nodo("F", $1, NULL, NULL);
+        $$ = crear_nodo(contexto, NODO_F, $1, NULL, NULL);
     }
   ;
 
 %%
 
-Nodo* crear_nodo(char *tipo, char *valor, Nodo *izq, Nodo *der) {
-    Nodo *nuevo = (Nodo*)malloc(sizeof(Nodo));
-    nuevo->tipo = strdup(tipo);
-    nuevo->valor = strdup(valor);
+void yyerror(yyscan_t escaner, ContextoAnalisis *contexto, const char *mensaje) {
+    (void)escaner;
+    contexto_diagnostico(contexto, "Error sintáctico en línea %d, columna %d: %s\n",
+                         contexto->linea, contexto->columna, mensaje);
+}
+
+// Entrega el resultado de una línea y deja el contexto listo para la
+// siguiente: sin diagnósticos y con la arena vacía. Al reducir FIN_LINEA el
+// parser no tiene un token de adelanto, así que nada en la pila apunta a la arena
+static void terminar_linea(ContextoAnalisis *contexto, int linea, Nodo *arbol) {
+    contexto->lineas++;
+    if (!arbol) {
+        contexto->lineas_con_error++;
+    }
+    if (contexto->al_terminar_linea) {
+        contexto->al_terminar_linea(contexto->datos_linea, linea, arbol, contexto->diagnosticos);
+    }
+
+    contexto_liberar(contexto);
+}
+
+void contexto_iniciar(ContextoAnalisis *contexto) {
+    contexto->linea = 1;
+    contexto->columna = 1;
+    contexto->raiz = NULL;
+    contexto->errores = 0;
+    contexto->diagnosticos = contexto->diagnosticos_inicial;
+    contexto->diagnosticos[0] = '\0';
+    contexto->longitud_diagnosticos = 0;
+    contexto->capacidad_diagnosticos = CONTEXTO_DIAGNOSTICOS;
+    contexto->bloques = NULL;
+    contexto->usado_inicial = 0;
+    contexto->reservas = 0;
+    contexto->token_inicial = 0;
+    contexto->fin_emitido = 0;
+    contexto->salto_pendiente = 0;
+    contexto->al_terminar_linea = NULL;
+    contexto->datos_linea = NULL;
+    contexto->lineas = 0;
+    contexto->lineas_con_error = 0;
+}
+
+// Libera el árbol de una vez junto con los bloques extra de la arena y
+// vacía los diagnósticos
+void contexto_liberar(ContextoAnalisis *contexto) {
+    BloqueArena *bloque = contexto->bloques;
+    while (bloque) {
+        BloqueArena *siguiente = bloque->siguiente;
+        free(bloque);
+        bloque = siguiente;
+    }
+    contexto->bloques = NULL;
+    contexto->usado_inicial = 0;
+    contexto->raiz = NULL;
+
+    if (contexto->diagnosticos != contexto->diagnosticos_inicial) {
+        free(contexto->diagnosticos);
+        contexto->diagnosticos = contexto->diagnosticos_inicial;
+        contexto->capacidad_diagnosticos = CONTEXTO_DIAGNOSTICOS;
+    }
+    contexto->diagnosticos[0] = '\0';
+    contexto->longitud_diagnosticos = 0;
+}
+
+// Agrega un mensaje a los diagnósticos; si no cabe, el búfer crece
+void contexto_diagnostico(ContextoAnalisis *contexto, const char *formato, ...) {
+    contexto->errores++;
+
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int necesarios = vsnprintf(NULL, 0, formato, argumentos);
+    va_end(argumentos);
+    if (necesarios <= 0) return;
+
+    size_t requerida = contexto->longitud_diagnosticos + (size_t)necesarios + 1;
+    if (requerida > contexto->capacidad_diagnosticos) {
+        size_t capacidad = contexto->capacidad_diagnosticos * 2;
+        while (capacidad < requerida) {
+            capacidad *= 2;
+        }
+        int en_linea = contexto->diagnosticos == contexto->diagnosticos_inicial;
+        char *nuevo = (char*)(en_linea ? malloc(capacidad) : realloc(contexto->diagnosticos, capacidad));
+        if (!nuevo) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para los diagnósticos\n");
+            return;
+        }
+        if (en_linea) {
+            memcpy(nuevo, contexto->diagnosticos_inicial, contexto->longitud_diagnosticos + 1);
+        }
+        contexto->diagnosticos = nuevo;
+        contexto->capacidad_diagnosticos = capacidad;
+        contexto->reservas++;
+    }
+
+    va_start(argumentos, formato);
+    vsnprintf(contexto->diagnosticos + contexto->longitud_diagnosticos,
+              contexto->capacidad_diagnosticos - contexto->longitud_diagnosticos, formato, argumentos);
+    va_end(argumentos);
+    contexto->longitud_diagnosticos += (size_t)necesarios;
+}
+
+void* contexto_asignar(ContextoAnalisis *contexto, size_t tamano) {
+    tamano = (tamano + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+
+    if (!contexto->bloques && CONTEXTO_ARENA - contexto->usado_inicial >= tamano) {
+        void *memoria = contexto->arena_inicial.datos + contexto->usado_inicial;
+        contexto->usado_inicial += tamano;
+        return memoria;
+    }
+
+    // Los bloques extra crecen al doble para que sean pocos
+    BloqueArena *bloque = contexto->bloques;
+    if (!bloque || bloque->capacidad - bloque->usado < tamano) {
+        size_t capacidad = bloque ? bloque->capacidad * 2 : CONTEXTO_ARENA * 2;
+        if (capacidad < tamano) {
+            capacidad = tamano;
+        }
+        BloqueArena *nuevo = (BloqueArena*)malloc(sizeof(BloqueArena) + capacidad);
+        if (!nuevo) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para el árbol\n");
+            return NULL;
+        }
+        contexto->reservas++;
+        nuevo->siguiente = bloque;
+        nuevo->capacidad = capacidad;
+        nuevo->usado = 0;
+        contexto->bloques = bloque = nuevo;
+    }
+
+    void *memoria = bloque->datos + bloque->usado;
+    bloque->usado += tamano;
+    return memoria;
+}
+
+char* contexto_copiar_cadena(ContextoAnalisis *contexto, const char *cadena, size_t longitud) {
+    char *copia = (char*)contexto_asignar(contexto, longitud + 1);
+    if (!copia) return NULL;
+
+    memcpy(copia, cadena, longitud);
+    copia[longitud] = '\0';
+    return copia;
+}
+
+Nodo* crear_nodo(ContextoAnalisis *contexto, TipoNodo tipo, const char *valor, Nodo *izq, Nodo *der) {
+    Nodo *nuevo = (Nodo*)contexto_asignar(contexto, sizeof(Nodo));
+    if (!nuevo) return NULL;
+
+    nuevo->tipo = tipo;
+    nuevo->valor = valor;
     nuevo->izquierdo = izq;
     nuevo->derecho = der;
     return nuevo;
 }
 
-void imprimir_arbol(Nodo *nodo, int nivel) {
+SerieNodos extender_serie(ContextoAnalisis *contexto, SerieNodos serie, TipoNodo tipo_raiz,
+                          TipoNodo tipo_interno, const char *operador, Nodo *termino) {
+    if (!serie.ultimo) {
+        // Segundo término: la serie pasa a tener raíz
+        serie.raiz = crear_nodo(contexto, tipo_raiz, operador, serie.raiz, termino);
+        serie.ultimo = serie.raiz;
+    } else {
+        // El último término baja a la izquierda de un nodo interno nuevo
+        Nodo *nodo = crear_nodo(contexto, tipo_interno, operador, serie.ultimo->derecho, termino);
+        if (nodo) {
+            serie.ultimo->derecho = nodo;
+            serie.ultimo = nodo;
+        }
+    }
+    return serie;
+}
+
+const char* nombre_tipo(TipoNodo tipo) {
+    static const char *const nombres[] = { "E", "E'", "T", "T'", "F" };
+    return nombres[tipo];
+}
+
+void imprimir_arbol(FILE *destino, Nodo *nodo, int nivel) {
     if (nodo == NULL) return;
-    
+
     for (int i = 0; i < nivel; i++) {
-        printf("  ");
+        fprintf(destino, "  ");
     }
-    
-    printf("%s: %s\n", nodo->tipo, nodo->valor);
-    
+
+    fprintf(destino, "%s: %s\n", nombre_tipo(nodo->tipo), nodo->valor);
+
     if (nodo->izquierdo != NULL) {
-        imprimir_arbol(nodo->izquierdo, nivel + 1);
+        imprimir_arbol(destino, nodo->izquierdo, nivel + 1);
     }
     if (nodo->derecho != NULL) {
-        imprimir_arbol(nodo->derecho, nivel + 1);
+        imprimir_arbol(destino, nodo->derecho, nivel + 1);
     }
 }
-
-void liberar_arbol(Nodo *nodo) {
-    if (nodo == NULL) return;
-    
-    liberar_arbol(nodo->izquierdo);
-    liberar_arbol(nodo->derecho);
-    free(nodo->tipo);
-    free(nodo->valor);
-    free(nodo);
-}
-
-int main() {
-    printf("=== PARSER LL(1) CON LEX/YACC ===\n");
-    printf("Gramática:\n");
-    printf("E  -> T E'\n");
-    printf("E' -> + T E' | ε\n");
-    printf("T  -> F T'\n");
-    printf("T' -> * F T' | ε\n");
-    printf("F  -> ( E ) | ident\n\n");
-    
-    printf("Ingrese una expresión (Ctrl+D para terminar):\n");
-    
-    if (yyparse() == 0) {
-        printf("\n=== ANÁLISIS SINTÁCTICO EXITOSO ===\n");
-        printf("Árbol de análisis sintáctico:\n");
-        imprimir_arbol(raiz_arbol, 0);
-        liberar_arbol(raiz_arbol);
-    } else {
-        printf("\n=== ERROR EN EL ANÁLISIS SINTÁCTICO ===\n");
-    }
-    
-    return 0;
-}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+#define ARENA_ALINEACION sizeof(void*)
+#define ARENA_BLOQUE_MAXIMO (4u * 1024u * 1024u)
+
+static size_t alinear(size_t tamano) {
+    return (tamano + (ARENA_ALINEACION - 1)) & ~(size_t)(ARENA_ALINEACION - 1);
+}
+
+void arena_iniciar(Arena *arena, size_t tamano_bloque) {
+    arena->actual = NULL;
+    arena->tamano_bloque = tamano_bloque;
+    arena->bytes_reservados = 0;
+}
+
+// Reserva un bloque nuevo; los bloques crecen al doble hasta ARENA_BLOQUE_MAXIMO
+// para que el número de bloques (y el costo de liberar) sea logarítmico
+static BloqueArena* nuevo_bloque(Arena *arena, size_t minimo) {
+    size_t capacidad = arena->tamano_bloque;
+    if (arena->actual && arena->actual->capacidad * 2 <= ARENA_BLOQUE_MAXIMO) {
+        capacidad = arena->actual->capacidad * 2;
+    }
+    if (capacidad < minimo) {
+        capacidad = minimo;
+    }
+
+    BloqueArena *bloque = (BloqueArena*)malloc(sizeof(BloqueArena) + capacidad);
+    if (!bloque) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la arena\n");
+        return NULL;
+    }
+
+    bloque->siguiente = arena->actual;
+    bloque->capacidad = capacidad;
+    bloque->usado = 0;
+    arena->actual = bloque;
+    arena->bytes_reservados += capacidad;
+
+    return bloque;
+}
+
+void* arena_asignar(Arena *arena, size_t tamano) {
+    tamano = alinear(tamano);
+
+    BloqueArena *bloque = arena->actual;
+    if (!bloque || bloque->capacidad - bloque->usado < tamano) {
+        bloque = nuevo_bloque(arena, tamano);
+        if (!bloque) return NULL;
+    }
+
+    void *memoria = bloque->datos + bloque->usado;
+    bloque->usado += tamano;
+    return memoria;
+}
+
+char* arena_copiar_cadena(Arena *arena, const char *cadena, size_t longitud) {
+    char *copia = (char*)arena_asignar(arena, longitud + 1);
+    if (!copia) return NULL;
+
+    memcpy(copia, cadena, longitud);
+    copia[longitud] = '\0';
+    return copia;
+}
+
+void arena_liberar(Arena *arena) {
+    BloqueArena *bloque = arena->actual;
+    while (bloque) {
+        BloqueArena *siguiente = bloque->siguiente;
+        free(bloque);
+        bloque = siguiente;
+    }
+    arena->actual = NULL;
+    arena->bytes_reservados = 0;
+}
+
+void arena_reiniciar(Arena *arena) {
+    BloqueArena *mayor = arena->actual;
+    for (BloqueArena *bloque = arena->actual; bloque; bloque = bloque->siguiente) {
+        if (bloque->capacidad > mayor->capacidad) {
+            mayor = bloque;
+        }
+    }
+
+    BloqueArena *bloque = arena->actual;
+    while (bloque) {
+        BloqueArena *siguiente = bloque->siguiente;
+        if (bloque != mayor) {
+            free(bloque);
+        }
+        bloque = siguiente;
+    }
+
+    arena->actual = mayor;
+    arena->bytes_reservados = 0;
+    if (mayor) {
+        mayor->siguiente = NULL;
+        mayor->usado = 0;
+        arena->bytes_reservados = mayor->capacidad;
+    }
+}
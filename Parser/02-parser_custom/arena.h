@@ -0,0 +1,32 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Bloque de memoria de la arena (lista enlazada de bloques)
+typedef struct BloqueArena {
+    struct BloqueArena *siguiente;
+    size_t capacidad;
+    size_t usado;
+    unsigned char datos[];
+} BloqueArena;
+
+// Arena (región) de memoria: asignación por desplazamiento de puntero
+// y liberación de todo su contenido de una sola vez
+typedef struct {
+    BloqueArena *actual;
+    size_t tamano_bloque;
+    size_t bytes_reservados;
+} Arena;
+
+// Funciones de la arena
+void arena_iniciar(Arena *arena, size_t tamano_bloque);
+void* arena_asignar(Arena *arena, size_t tamano);
+char* arena_copiar_cadena(Arena *arena, const char *cadena, size_t longitud);
+void arena_liberar(Arena *arena);
+
+// Descarta todo el contenido pero conserva el bloque más grande, para que
+// reutilizar la arena con entradas parecidas no vuelva a reservar memoria
+void arena_reiniciar(Arena *arena);
+
+#endif // ARENA_H
@@ -0,0 +1,55 @@
+// Benchmark: construcción y liberación del árbol con malloc por nodo
+// frente a la arena del parser.
+// Uso: bench_arena <malloc|arena> [expresiones] [terminos]
+
+#include "parser.h"
+#include "bench_util.h"
+
+static long contar_nodos(NodoArbol *nodo) {
+    if (!nodo) return 0;
+    return 1 + contar_nodos(nodo->izquierdo) + contar_nodos(nodo->derecho);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || (strcmp(argv[1], "malloc") != 0 && strcmp(argv[1], "arena") != 0)) {
+        fprintf(stderr, "Uso: %s <malloc|arena> [expresiones] [terminos]\n", argv[0]);
+        return 1;
+    }
+    int usar_arena = strcmp(argv[1], "arena") == 0;
+    int expresiones = argc > 2 ? atoi(argv[2]) : 2000;
+    int terminos = argc > 3 ? atoi(argv[3]) : 2000;
+
+    GeneradorBench g = { 42 };
+    TextoBench expr = { NULL, 0, 0 };
+    bench_generar_expresion(&g, &expr, terminos, 8, 6);
+
+    // Contar los nodos de un árbol fuera de la medición
+    Parser *muestra = crear_parser(expr.datos);
+    NodoArbol *arbol_muestra = muestra ? analizar(muestra) : NULL;
+    if (!arbol_muestra) return 1;
+    long nodos_por_expresion = contar_nodos(arbol_muestra);
+    liberar_parser(muestra);
+
+    long nodos = 0;
+    double inicio = bench_segundos();
+
+    for (int i = 0; i < expresiones; i++) {
+        Parser *parser = crear_parser(expr.datos);
+        if (!parser) return 1;
+        parser->usar_arena = usar_arena;
+
+        NodoArbol *arbol = analizar(parser);
+        if (!arbol) return 1;
+        nodos += nodos_por_expresion;
+
+        liberar_arbol(arbol);
+        liberar_parser(parser);
+    }
+
+    double segundos = bench_segundos() - inicio;
+    printf("modo=%s expresiones=%d terminos=%d nodos=%ld segundos=%.3f nodos_por_seg=%.0f rss_pico_kb=%ld\n",
+           argv[1], expresiones, terminos, nodos, segundos, nodos / segundos, bench_rss_pico_kb());
+
+    free(expr.datos);
+    return 0;
+}
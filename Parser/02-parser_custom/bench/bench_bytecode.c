@@ -0,0 +1,94 @@
+// Benchmark: evaluación de una expresión con muchos juegos de valores para
+// sus variables, recorriendo el árbol recursivamente frente al bytecode
+// compilado. Los dos modos deben dar exactamente el mismo resultado.
+// Uso: bench_bytecode [operandos_por_caso]
+
+#include "bytecode.h"
+#include "bench_util.h"
+
+// Evaluación directa del árbol. 'variable_de_simbolo' traduce el símbolo de
+// cada identificador (en la tabla del parser) a su índice en 'valores'
+static double evaluar_arbol(const NodoArbol *nodo, const double *valores, const int *variable_de_simbolo) {
+    switch (nodo->tipo) {
+        case NODO_IDENTIFICADOR:
+            return valores[variable_de_simbolo[nodo->simbolo]];
+        case NODO_PARENTESIS:
+            return evaluar_arbol(nodo->izquierdo, valores, variable_de_simbolo);
+        case NODO_SUMA:
+            return evaluar_arbol(nodo->izquierdo, valores, variable_de_simbolo) +
+                   evaluar_arbol(nodo->derecho, valores, variable_de_simbolo);
+        default:
+            return evaluar_arbol(nodo->izquierdo, valores, variable_de_simbolo) *
+                   evaluar_arbol(nodo->derecho, valores, variable_de_simbolo);
+    }
+}
+
+static void medir(int terminos, long evaluaciones) {
+    GeneradorBench g = { 5 };
+    TextoBench expr = { NULL, 0, 0 };
+    bench_generar_expresion(&g, &expr, terminos, 8, 2);
+
+    Parser *parser = crear_parser(expr.datos);
+    NodoArbol *arbol = parser ? analizar(parser) : NULL;
+    Programa programa;
+    if (!arbol || !programa_compilar(&programa, arbol)) exit(1);
+
+    uint32_t num_variables = programa.variables.num_simbolos;
+    int *variable_de_simbolo = (int*)malloc(parser->simbolos->num_simbolos * sizeof(int));
+    for (uint32_t s = 0; s < parser->simbolos->num_simbolos; s++) {
+        variable_de_simbolo[s] = programa_variable(&programa, simbolos_nombre(parser->simbolos, s));
+    }
+
+    // Juegos de valores en [0.5, 1.5): los productos largos no se desbordan
+    int num_juegos = 1024;
+    double *valores = (double*)malloc((size_t)num_juegos * num_variables * sizeof(double));
+    for (size_t i = 0; i < (size_t)num_juegos * num_variables; i++) {
+        valores[i] = 0.5 + (double)(bench_aleatorio(&g) % 1000000) / 1e6;
+    }
+    for (int j = 0; j < num_juegos; j++) {
+        const double *juego = valores + (size_t)j * num_variables;
+        if (evaluar_arbol(arbol, juego, variable_de_simbolo) != programa_evaluar(&programa, juego)) {
+            fprintf(stderr, "Error: el bytecode y el árbol no dan el mismo resultado\n");
+            exit(1);
+        }
+    }
+
+    // Evitar que el compilador descarte las evaluaciones
+    volatile double suma = 0.0;
+
+    double inicio = bench_segundos();
+    for (long i = 0; i < evaluaciones; i++) {
+        suma += evaluar_arbol(arbol, valores + (size_t)(i % num_juegos) * num_variables, variable_de_simbolo);
+    }
+    double segundos_arbol = bench_segundos() - inicio;
+
+    inicio = bench_segundos();
+    for (long i = 0; i < evaluaciones; i++) {
+        suma += programa_evaluar(&programa, valores + (size_t)(i % num_juegos) * num_variables);
+    }
+    double segundos_bytecode = bench_segundos() - inicio;
+
+    printf("modo=arbol terminos=%d variables=%u evaluaciones=%ld ns_por_evaluacion=%.1f\n",
+           terminos, num_variables, evaluaciones, segundos_arbol * 1e9 / evaluaciones);
+    printf("modo=bytecode terminos=%d variables=%u evaluaciones=%ld instrucciones=%u max_pila=%u "
+           "ns_por_evaluacion=%.1f aceleracion=%.2f\n",
+           terminos, num_variables, evaluaciones, programa.num_instrucciones, programa.max_pila,
+           segundos_bytecode * 1e9 / evaluaciones, segundos_arbol / segundos_bytecode);
+
+    free(valores);
+    free(variable_de_simbolo);
+    programa_liberar(&programa);
+    liberar_parser(parser);
+    free(expr.datos);
+}
+
+int main(int argc, char *argv[]) {
+    // Misma cantidad de operandos evaluados en cada caso
+    long operandos = argc > 1 ? atol(argv[1]) : 50000000L;
+
+    static const int terminos[] = { 8, 64, 1024, 16384 };
+    for (size_t i = 0; i < sizeof(terminos) / sizeof(terminos[0]); i++) {
+        medir(terminos[i], operandos / terminos[i]);
+    }
+    return 0;
+}
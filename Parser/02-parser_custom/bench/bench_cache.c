@@ -0,0 +1,103 @@
+// Benchmark: cache de análisis con entradas repetidas. Un corpus de líneas
+// sacadas con sesgo de un conjunto de expresiones distintas (con blancos
+// variados y algunos errores) se procesa sin cache, con una cache en la que
+// caben todas y con una cache pequeña que obliga a desalojar. La salida debe
+// ser idéntica en los tres casos.
+// Uso: bench_cache [lineas] [distintas]
+
+#include "lote.h"
+#include "bench_util.h"
+
+// Procesa todas las líneas y devuelve la salida completa
+static Salida procesar(const char *caso, const TextoBench *corpus, long lineas, CacheAnalisis *cache) {
+    OpcionesLote opciones = { &emisor_indentado, 0, cache };
+    TablaSimbolos simbolos;
+    simbolos_iniciar(&simbolos);
+    Salida salida;
+    salida_iniciar(&salida);
+
+    long validas = 0;
+    int numero_linea = 1;
+    const char *cursor = corpus->datos;
+    const char *fin = corpus->datos + corpus->longitud;
+    double inicio = bench_segundos();
+    while (cursor < fin) {
+        const char *salto = memchr(cursor, '\n', (size_t)(fin - cursor));
+        size_t longitud = (size_t)(salto - cursor);
+        validas += procesar_entrada_n(&salida, &simbolos, &opciones, numero_linea++, cursor, longitud);
+        cursor = salto + 1;
+    }
+    double segundos = bench_segundos() - inicio;
+
+    printf("caso=%s lineas=%ld validas=%ld ms=%.1f lineas_por_s=%.0f", caso, lineas, validas,
+           segundos * 1e3, lineas / segundos);
+    if (cache) {
+        unsigned long consultas = cache->aciertos + cache->fallos;
+        printf(" aciertos=%lu fallos=%lu tasa=%.3f desalojos=%lu entradas=%u kb=%.0f", cache->aciertos,
+               cache->fallos, consultas ? (double)cache->aciertos / consultas : 0.0, cache->desalojos,
+               cache->num_entradas, cache->bytes / 1024.0);
+    }
+    printf("\n");
+    simbolos_liberar(&simbolos);
+    return salida;
+}
+
+static void comparar(const Salida *referencia, Salida *salida, const char *caso) {
+    if (salida->longitud != referencia->longitud ||
+        memcmp(salida->datos, referencia->datos, referencia->longitud) != 0) {
+        fprintf(stderr, "Error: la salida con %s no coincide con la salida sin cache\n", caso);
+        exit(1);
+    }
+    salida_liberar(salida);
+}
+
+int main(int argc, char *argv[]) {
+    long lineas = argc > 1 ? atol(argv[1]) : 200000;
+    int distintas = argc > 2 ? atoi(argv[2]) : 4000;
+    GeneradorBench g = { 23 };
+
+    // Expresiones distintas de 8 a 40 términos; una de cada 16 con un error
+    TextoBench *expresiones = (TextoBench*)calloc((size_t)distintas, sizeof(TextoBench));
+    for (int i = 0; i < distintas; i++) {
+        bench_generar_expresion(&g, &expresiones[i], 8 + (int)(bench_aleatorio(&g) % 33), 3, 3);
+        if (i % 16 == 15) {
+            bench_agregar(&expresiones[i], " + )", 4);
+        }
+    }
+
+    // Sesgo: el mínimo de dos sorteos favorece a las primeras expresiones.
+    // La mitad de las líneas válidas lleva blancos extra al principio
+    TextoBench corpus = { NULL, 0, 0 };
+    for (long i = 0; i < lineas; i++) {
+        unsigned int a = bench_aleatorio(&g) % (unsigned int)distintas;
+        unsigned int b = bench_aleatorio(&g) % (unsigned int)distintas;
+        unsigned int elegida = a < b ? a : b;
+        if (elegida % 16 != 15 && bench_aleatorio(&g) % 2 == 0) {
+            bench_agregar(&corpus, "\t  ", 3);
+        }
+        bench_agregar(&corpus, expresiones[elegida].datos, expresiones[elegida].longitud);
+        bench_agregar(&corpus, "\n", 1);
+    }
+
+    Salida referencia = procesar("sin_cache", &corpus, lineas, NULL);
+
+    CacheAnalisis grande;
+    cache_iniciar(&grande, (size_t)256 << 20, &emisor_indentado);
+    Salida salida = procesar("cache_grande", &corpus, lineas, &grande);
+    comparar(&referencia, &salida, "la cache grande");
+    cache_liberar(&grande);
+
+    CacheAnalisis pequena;
+    cache_iniciar(&pequena, (size_t)4 << 20, &emisor_indentado);
+    salida = procesar("cache_pequena", &corpus, lineas, &pequena);
+    comparar(&referencia, &salida, "la cache pequeña");
+    cache_liberar(&pequena);
+
+    salida_liberar(&referencia);
+    for (int i = 0; i < distintas; i++) {
+        free(expresiones[i].datos);
+    }
+    free(expresiones);
+    free(corpus.datos);
+    return 0;
+}
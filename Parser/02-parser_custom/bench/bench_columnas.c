@@ -0,0 +1,113 @@
+// Benchmark: evaluación de una expresión en todas las filas de una tabla por
+// columnas. Compara la máquina virtual fila por fila (juntando los valores de
+// cada fila) con la evaluación por bloques con cada núcleo y con varios
+// hilos. Todos los modos deben dar exactamente los mismos resultados.
+// Uso: bench_columnas [filas] [hilos]
+
+#include <unistd.h>
+#include "columnas.h"
+#include "bench_util.h"
+
+static void informar(const char *modo, int terminos, uint32_t num_variables, size_t filas, int hilos,
+                     double segundos, double segundos_base) {
+    // Bytes que pasan por memoria: cada columna se lee y el resultado se escribe
+    double bytes = (double)filas * (num_variables + 1) * sizeof(double);
+    printf("modo=%s terminos=%d variables=%u filas=%zu hilos=%d ns_por_fila=%.2f gb_por_segundo=%.2f "
+           "aceleracion=%.2f\n", modo, terminos, num_variables, filas, hilos, segundos * 1e9 / filas,
+           bytes / segundos / 1e9, segundos_base / segundos);
+}
+
+static void comprobar(const double *esperado, const double *obtenido, size_t filas, const char *modo) {
+    if (memcmp(esperado, obtenido, filas * sizeof(double)) != 0) {
+        fprintf(stderr, "Error: el modo %s no da los mismos resultados que la evaluación por filas\n", modo);
+        exit(1);
+    }
+}
+
+static void medir(int terminos, size_t filas, int hilos) {
+    GeneradorBench g = { 11 };
+    TextoBench expr = { NULL, 0, 0 };
+    bench_generar_expresion(&g, &expr, terminos, 4, 1);
+
+    Parser *parser = crear_parser(expr.datos);
+    NodoArbol *arbol = parser ? analizar(parser) : NULL;
+    Programa programa;
+    if (!arbol || !programa_compilar(&programa, arbol)) exit(1);
+
+    // Columnas con valores en [0.5, 1.5): los productos no se desbordan
+    uint32_t num_variables = programa.variables.num_simbolos;
+    double **columnas = (double**)malloc(num_variables * sizeof(double*));
+    for (uint32_t v = 0; v < num_variables; v++) {
+        columnas[v] = (double*)malloc(filas * sizeof(double));
+        if (!columnas[v]) exit(1);
+        for (size_t f = 0; f < filas; f++) {
+            columnas[v][f] = 0.5 + (double)(bench_aleatorio(&g) % 1000000) / 1e6;
+        }
+    }
+    double *esperado = (double*)malloc(filas * sizeof(double));
+    double *resultado = (double*)malloc(filas * sizeof(double));
+    double *fila_valores = (double*)malloc(num_variables * sizeof(double));
+    if (!esperado || !resultado || !fila_valores) exit(1);
+
+    // Referencia: la máquina virtual fila por fila
+    double inicio = bench_segundos();
+    for (size_t f = 0; f < filas; f++) {
+        for (uint32_t v = 0; v < num_variables; v++) {
+            fila_valores[v] = columnas[v][f];
+        }
+        esperado[f] = programa_evaluar(&programa, fila_valores);
+    }
+    double segundos_filas = bench_segundos() - inicio;
+    informar("filas", terminos, num_variables, filas, 1, segundos_filas, segundos_filas);
+
+    const double *const *entrada = (const double *const *)columnas;
+    static const KernelColumnas kernels[] = { KERNEL_COLUMNAS_ESCALAR, KERNEL_COLUMNAS_SSE2, KERNEL_COLUMNAS_AVX2 };
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (!columnas_seleccionar(kernels[k])) {
+            continue;
+        }
+        memset(resultado, 0, filas * sizeof(double));
+        inicio = bench_segundos();
+        if (!evaluar_columnas(&programa, entrada, filas, resultado, 1)) exit(1);
+        double segundos = bench_segundos() - inicio;
+        comprobar(esperado, resultado, filas, columnas_nombre_kernel());
+        informar(columnas_nombre_kernel(), terminos, num_variables, filas, 1, segundos, segundos_filas);
+    }
+
+    // Mejor núcleo repartido entre hilos
+    columnas_seleccionar(KERNEL_COLUMNAS_AUTO);
+    memset(resultado, 0, filas * sizeof(double));
+    inicio = bench_segundos();
+    if (!evaluar_columnas(&programa, entrada, filas, resultado, hilos)) exit(1);
+    double segundos = bench_segundos() - inicio;
+    comprobar(esperado, resultado, filas, "hilos");
+    char modo[32];
+    snprintf(modo, sizeof(modo), "%s_hilos", columnas_nombre_kernel());
+    informar(modo, terminos, num_variables, filas, hilos, segundos, segundos_filas);
+
+    for (uint32_t v = 0; v < num_variables; v++) {
+        free(columnas[v]);
+    }
+    free(columnas);
+    free(esperado);
+    free(resultado);
+    free(fila_valores);
+    programa_liberar(&programa);
+    liberar_parser(parser);
+    free(expr.datos);
+}
+
+int main(int argc, char *argv[]) {
+    size_t filas = argc > 1 ? (size_t)atol(argv[1]) : 2000000;
+    int hilos = argc > 2 ? atoi(argv[2]) : 0;
+    if (hilos <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        hilos = cpus > 0 ? (int)cpus : 1;
+    }
+
+    static const int terminos[] = { 4, 16, 64 };
+    for (size_t i = 0; i < sizeof(terminos) / sizeof(terminos[0]); i++) {
+        medir(terminos[i], filas, hilos);
+    }
+    return 0;
+}
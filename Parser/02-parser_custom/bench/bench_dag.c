@@ -0,0 +1,85 @@
+// Benchmark: árbol completo frente al DAG con subárboles compartidos
+// (hash consing). Mide nodos creados, memoria de la arena y tiempo.
+// Uso: bench_dag [terminos] [repeticiones]
+
+#include "parser.h"
+#include "bench_util.h"
+
+typedef struct {
+    long nodos;
+    size_t bytes_arena;
+    size_t bytes_tabla;
+    uint32_t hash;
+    double segundos;
+} ResultadoDag;
+
+static long contar_nodos(NodoArbol *raiz) {
+    long nodos = 0;
+    int capacidad = 64, cantidad = 0;
+    NodoArbol **pila = (NodoArbol**)malloc(capacidad * sizeof(NodoArbol*));
+    pila[cantidad++] = raiz;
+    while (cantidad > 0) {
+        NodoArbol *nodo = pila[--cantidad];
+        nodos++;
+        if (cantidad + 2 > capacidad) {
+            capacidad *= 2;
+            pila = (NodoArbol**)realloc(pila, capacidad * sizeof(NodoArbol*));
+        }
+        if (nodo->derecho) pila[cantidad++] = nodo->derecho;
+        if (nodo->izquierdo) pila[cantidad++] = nodo->izquierdo;
+    }
+    free(pila);
+    return nodos;
+}
+
+static ResultadoDag medir(const char *expresion, int repeticiones, int compartir) {
+    ResultadoDag resultado = { 0, 0, 0, 0, 0.0 };
+    double inicio = bench_segundos();
+
+    for (int i = 0; i < repeticiones; i++) {
+        Parser *parser = crear_parser(expresion);
+        if (!parser) exit(1);
+        parser->compartir_nodos = compartir;
+
+        NodoArbol *arbol = analizar(parser);
+        if (!arbol) exit(1);
+
+        if (i == 0) {
+            resultado.nodos = compartir ? (long)parser->nodos.num_nodos : contar_nodos(arbol);
+            resultado.bytes_arena = parser->arena.bytes_reservados;
+            resultado.bytes_tabla = parser->nodos.capacidad_casillas * sizeof(NodoCompartido*);
+            resultado.hash = hash_estructural(arbol);
+        }
+        liberar_parser(parser);
+    }
+
+    resultado.segundos = (bench_segundos() - inicio) / repeticiones;
+    return resultado;
+}
+
+int main(int argc, char *argv[]) {
+    int terminos = argc > 1 ? atoi(argv[1]) : 200000;
+    int repeticiones = argc > 2 ? atoi(argv[2]) : 5;
+
+    // Identificadores de 1 y 2 letras: vocabularios de 26 y 676 nombres
+    for (int longitud_ident = 1; longitud_ident <= 2; longitud_ident++) {
+        GeneradorBench g = { 7 };
+        TextoBench expr = { NULL, 0, 0 };
+        bench_generar_expresion(&g, &expr, terminos, 8, longitud_ident);
+
+        ResultadoDag arbol = medir(expr.datos, repeticiones, 0);
+        ResultadoDag dag = medir(expr.datos, repeticiones, 1);
+        if (arbol.hash != dag.hash) {
+            fprintf(stderr, "Error: el hash estructural del DAG no coincide con el del árbol\n");
+            return 1;
+        }
+
+        printf("modo=arbol longitud_ident=%d terminos=%d nodos=%ld bytes_arena=%zu bytes_tabla=%zu ms_por_expresion=%.2f\n",
+               longitud_ident, terminos, arbol.nodos, arbol.bytes_arena, arbol.bytes_tabla, arbol.segundos * 1e3);
+        printf("modo=dag longitud_ident=%d terminos=%d nodos=%ld bytes_arena=%zu bytes_tabla=%zu ms_por_expresion=%.2f\n",
+               longitud_ident, terminos, dag.nodos, dag.bytes_arena, dag.bytes_tabla, dag.segundos * 1e3);
+
+        free(expr.datos);
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Microbenchmark de los núcleos de escaneo del lexer (bytes por ciclo)
+// Uso: bench_escaneo [repeticiones]
+
+#include "lexer.h"
+#include "escaneo.h"
+#include "bench_util.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define CICLOS() __rdtsc()
+#define UNIDAD "ciclo"
+#else
+// Sin contador de ciclos se informa por nanosegundo
+#define CICLOS() ((unsigned long long)(bench_segundos() * 1e9))
+#define UNIDAD "ns"
+#endif
+
+#define TAMANO_CORPUS (4 * 1024 * 1024)
+
+// Texto con mucha indentación: líneas de 60 espacios/tabuladores y un identificador corto
+static void generar_indentado(TextoBench *t) {
+    while (t->longitud < TAMANO_CORPUS) {
+        bench_agregar(t, "\n                                                        \t\t\tx", 61);
+    }
+}
+
+// Identificadores largos separados por un solo espacio
+static void generar_identificadores(TextoBench *t, GeneradorBench *g) {
+    char ident[121];
+    while (t->longitud < TAMANO_CORPUS) {
+        for (int i = 0; i < 120; i++) {
+            unsigned int r = bench_aleatorio(g) % 64;
+            ident[i] = r < 26 ? (char)('a' + r) : r < 52 ? (char)('A' + r - 26) : r < 62 ? (char)('0' + r - 52) : '_';
+        }
+        ident[0] = 'v';
+        ident[120] = ' ';
+        bench_agregar(t, ident, sizeof(ident));
+    }
+}
+
+// Recorre el corpus alternando espacios e identificadores con los núcleos activos
+static unsigned long long recorrer(const TextoBench *t) {
+    size_t i = 0;
+    unsigned long long control = 0;
+    while (i < t->longitud) {
+        RachaEspacios racha = escanear_espacios(t->datos + i, t->longitud - i);
+        i += racha.longitud;
+        control += (unsigned long long)racha.saltos;
+        size_t n = escanear_identificador(t->datos + i, t->longitud - i);
+        i += n ? n : 1;
+        control += n;
+    }
+    return control;
+}
+
+// Tokeniza el corpus completo con el lexer
+static unsigned long long tokenizar(const TextoBench *t) {
+    Lexer *lexer = crear_lexer_n(t->datos, (int)t->longitud);
+    unsigned long long tokens = 0;
+    Token token;
+    do {
+        token = obtener_siguiente_token(lexer);
+        tokens++;
+    } while (token.tipo != TOKEN_EOF);
+    liberar_lexer(lexer);
+    return tokens;
+}
+
+static void medir(const char *corpus, const TextoBench *t, int repeticiones, int lexer_completo) {
+    const KernelEscaneo kernels[] = { KERNEL_ESCALAR, KERNEL_SSE2, KERNEL_AVX2 };
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        if (!escaneo_seleccionar(kernels[k])) continue;
+        unsigned long long control = 0;
+        unsigned long long inicio = CICLOS();
+        for (int r = 0; r < repeticiones; r++) {
+            control += lexer_completo ? tokenizar(t) : recorrer(t);
+        }
+        unsigned long long ciclos = CICLOS() - inicio;
+        printf("prueba=%s corpus=%s kernel=%s bytes=%zu bytes_por_%s=%.3f control=%llu\n",
+               lexer_completo ? "lexer" : "nucleos", corpus, escaneo_nombre_kernel(),
+               t->longitud, UNIDAD, (double)t->longitud * repeticiones / (double)ciclos, control);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int repeticiones = argc > 1 ? atoi(argv[1]) : 20;
+    GeneradorBench g = { 7 };
+    TextoBench indentado = { NULL, 0, 0 };
+    TextoBench identificadores = { NULL, 0, 0 };
+    generar_indentado(&indentado);
+    generar_identificadores(&identificadores, &g);
+
+    medir("indentado", &indentado, repeticiones, 0);
+    medir("identificadores", &identificadores, repeticiones, 0);
+    medir("indentado", &indentado, repeticiones, 1);
+    medir("identificadores", &identificadores, repeticiones, 1);
+
+    free(indentado.datos);
+    free(identificadores.datos);
+    return 0;
+}
@@ -0,0 +1,228 @@
+// Benchmark: análisis incremental frente a reanalizar la expresión completa
+// en cada edición, reproduciendo secuencias de ediciones sobre una expresión
+// larga. Antes de medir, una secuencia de ediciones aleatorias (que pasan
+// por textos no válidos) se compara nodo a nodo, con posiciones, contra el
+// análisis completo.
+// Uso: bench_incremental [terminos] [ediciones]
+
+#include "incremental.h"
+#include "bench_util.h"
+
+// Compara dos árboles: tipo, valor, linea y columna de cada nodo
+static int mismos_arboles(const NodoArbol *a, const NodoArbol *b) {
+    int capacidad = 64, cantidad = 0;
+    const NodoArbol **pila = (const NodoArbol**)malloc(capacidad * 2 * sizeof(NodoArbol*));
+    int iguales = 1;
+    pila[cantidad++] = a;
+    pila[cantidad++] = b;
+    while (cantidad > 0 && iguales) {
+        const NodoArbol *y = pila[--cantidad];
+        const NodoArbol *x = pila[--cantidad];
+        if (!x || !y) {
+            iguales = x == y;
+            continue;
+        }
+        iguales = x->tipo == y->tipo && x->linea == y->linea && x->columna == y->columna &&
+                  (x->tipo != NODO_IDENTIFICADOR || strcmp(x->valor, y->valor) == 0);
+        if (cantidad + 4 > capacidad * 2) {
+            capacidad *= 2;
+            pila = (const NodoArbol**)realloc(pila, capacidad * 2 * sizeof(NodoArbol*));
+        }
+        pila[cantidad++] = x->izquierdo;
+        pila[cantidad++] = y->izquierdo;
+        pila[cantidad++] = x->derecho;
+        pila[cantidad++] = y->derecho;
+    }
+    free(pila);
+    return iguales;
+}
+
+static int verificar_contra_completo(DocumentoIncremental *documento) {
+    Parser *parser = crear_parser_n(documento->texto, documento->longitud);
+    if (!parser) exit(1);
+    NodoArbol *completo = analizar(parser);
+    incremental_actualizar_posiciones(documento);
+
+    int correcto;
+    if (!completo || !documento->arbol) {
+        correcto = !completo && !documento->arbol &&
+                   strcmp(parser->mensaje_error, documento->mensaje_error) == 0;
+    } else {
+        correcto = mismos_arboles(completo, documento->arbol);
+    }
+    liberar_parser(parser);
+    return correcto;
+}
+
+// Ediciones aleatorias de hasta tres bytes con caracteres de la gramática
+// (y saltos de línea). Las que dejan el texto no válido se deshacen con otra
+// edición, para que la mayoría se haga sobre un árbol válido
+static int verificar(int terminos, int ediciones) {
+    static const char alfabeto[] = "abc+*()  \n";
+    GeneradorBench g = { 11 };
+    TextoBench expr = { NULL, 0, 0 };
+    bench_generar_expresion(&g, &expr, terminos, 4, 1);
+
+    DocumentoIncremental documento;
+    if (!incremental_iniciar(&documento, expr.datos, (int)expr.longitud)) exit(1);
+
+    for (int i = 0; i < ediciones; i++) {
+        int desplazamiento = (int)(bench_aleatorio(&g) % (documento.longitud + 1));
+        int borrados = (int)(bench_aleatorio(&g) % 3);
+        if (desplazamiento + borrados > documento.longitud) {
+            borrados = documento.longitud - desplazamiento;
+        }
+        char insertado[3];
+        int longitud_insertado = (int)(bench_aleatorio(&g) % 4);
+        for (int k = 0; k < longitud_insertado; k++) {
+            insertado[k] = alfabeto[bench_aleatorio(&g) % (sizeof(alfabeto) - 1)];
+        }
+        char borrado[2];
+        memcpy(borrado, documento.texto + desplazamiento, borrados);
+        if (!incremental_editar(&documento, desplazamiento, borrados, insertado, longitud_insertado) ||
+            !verificar_contra_completo(&documento)) {
+            fprintf(stderr, "Error: la edición %d no coincide con el análisis completo: \"%s\"\n",
+                    i, documento.texto);
+            return 0;
+        }
+        if (!documento.arbol &&
+            (!incremental_editar(&documento, desplazamiento, longitud_insertado, borrado, borrados) ||
+             !verificar_contra_completo(&documento))) {
+            fprintf(stderr, "Error: deshacer la edición %d no coincide con el análisis completo: \"%s\"\n",
+                    i, documento.texto);
+            return 0;
+        }
+    }
+
+    incremental_liberar(&documento);
+    free(expr.datos);
+    return 1;
+}
+
+// Una edición de una secuencia
+typedef struct {
+    int desplazamiento;
+    int borrados;
+    const char *insertado;
+} Edicion;
+
+// Escenarios (todos mantienen la expresión válida):
+//  renombrar: cambia una letra de un identificador al azar
+//  insertar:  agrega " * q" detrás de un identificador al azar y lo quita
+//  agregar:   agrega " + z" al final y lo quita (escribir al final de la línea)
+static int generar_edicion(GeneradorBench *g, const char *escenario, const char *texto, int longitud,
+                           int paso, Edicion *anterior, Edicion *edicion) {
+    static const char *letras[] = { "a", "b", "c", "d", "e", "f", "g", "h" };
+    if (paso % 2 == 1 && strcmp(escenario, "renombrar") != 0) {
+        // Deshacer la edición anterior
+        edicion->desplazamiento = anterior->desplazamiento;
+        edicion->borrados = (int)strlen(anterior->insertado);
+        edicion->insertado = "";
+        return 1;
+    }
+    if (strcmp(escenario, "agregar") == 0) {
+        edicion->desplazamiento = longitud;
+        edicion->borrados = 0;
+        edicion->insertado = " + z";
+        return 1;
+    }
+
+    // Un identificador al azar
+    int posicion = (int)(bench_aleatorio(g) % longitud);
+    while (posicion < longitud && !(texto[posicion] >= 'a' && texto[posicion] <= 'z')) {
+        posicion++;
+    }
+    if (posicion == longitud) {
+        posicion = 0;
+        while (!(texto[posicion] >= 'a' && texto[posicion] <= 'z')) posicion++;
+    }
+    if (strcmp(escenario, "renombrar") == 0) {
+        edicion->desplazamiento = posicion;
+        edicion->borrados = 1;
+        edicion->insertado = letras[bench_aleatorio(g) % 8];
+    } else {
+        while (posicion < longitud && texto[posicion] >= 'a' && texto[posicion] <= 'z') {
+            posicion++;
+        }
+        edicion->desplazamiento = posicion;
+        edicion->borrados = 0;
+        edicion->insertado = " * q";
+    }
+    return 1;
+}
+
+static void medir(const char *escenario, int terminos, int ediciones) {
+    GeneradorBench g = { 7 };
+    TextoBench expr = { NULL, 0, 0 };
+    bench_generar_expresion(&g, &expr, terminos, 8, 2);
+
+    // Las mismas ediciones para los dos modos
+    Edicion *secuencia = (Edicion*)malloc(ediciones * sizeof(Edicion));
+    DocumentoIncremental documento;
+    if (!secuencia || !incremental_iniciar(&documento, expr.datos, (int)expr.longitud)) exit(1);
+    long long bytes_iniciales = documento.bytes_reanalizados;
+
+    double inicio = bench_segundos();
+    for (int i = 0; i < ediciones; i++) {
+        generar_edicion(&g, escenario, documento.texto, documento.longitud, i,
+                        i > 0 ? &secuencia[i - 1] : NULL, &secuencia[i]);
+        Edicion *e = &secuencia[i];
+        if (!incremental_editar(&documento, e->desplazamiento, e->borrados, e->insertado, (int)strlen(e->insertado)) ||
+            !documento.arbol) {
+            fprintf(stderr, "Error: la edición %d dejó la expresión no válida\n", i);
+            exit(1);
+        }
+    }
+    double segundos_incremental = bench_segundos() - inicio;
+
+    if (!verificar_contra_completo(&documento)) {
+        fprintf(stderr, "Error: el árbol incremental no coincide con el análisis completo\n");
+        exit(1);
+    }
+
+    // Reanalizar todo en cada edición, sobre el mismo texto
+    char *texto = (char*)malloc(documento.capacidad + 1);
+    int longitud = (int)expr.longitud;
+    memcpy(texto, expr.datos, expr.longitud);
+    inicio = bench_segundos();
+    for (int i = 0; i < ediciones; i++) {
+        Edicion *e = &secuencia[i];
+        int insertados = (int)strlen(e->insertado);
+        memmove(texto + e->desplazamiento + insertados, texto + e->desplazamiento + e->borrados,
+                longitud - e->desplazamiento - e->borrados);
+        memcpy(texto + e->desplazamiento, e->insertado, insertados);
+        longitud += insertados - e->borrados;
+
+        Parser *parser = crear_parser_n(texto, longitud);
+        if (!parser || !analizar(parser)) exit(1);
+        liberar_parser(parser);
+    }
+    double segundos_completo = bench_segundos() - inicio;
+
+    printf("escenario=%s terminos=%d bytes=%d ediciones=%d us_por_edicion_incremental=%.2f "
+           "us_por_edicion_completo=%.2f bytes_reanalizados_por_edicion=%.1f reanalisis_completos=%ld\n",
+           escenario, terminos, longitud, ediciones, segundos_incremental * 1e6 / ediciones,
+           segundos_completo * 1e6 / ediciones,
+           (double)(documento.bytes_reanalizados - bytes_iniciales) / ediciones,
+           documento.reanalisis_completos - 1);
+
+    free(texto);
+    free(secuencia);
+    incremental_liberar(&documento);
+    free(expr.datos);
+}
+
+int main(int argc, char *argv[]) {
+    int terminos = argc > 1 ? atoi(argv[1]) : 20000;
+    int ediciones = argc > 2 ? atoi(argv[2]) : 500;
+
+    if (!verificar(40, 20000)) {
+        return 1;
+    }
+    printf("verificacion=ok ediciones_aleatorias=20000\n");
+
+    medir("renombrar", terminos, ediciones);
+    medir("insertar", terminos, ediciones);
+    medir("agregar", terminos, ediciones);
+    return 0;
+}
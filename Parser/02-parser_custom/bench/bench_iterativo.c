@@ -0,0 +1,38 @@
+// Benchmark: parser iterativo con pila explícita frente al descenso recursivo
+// Uso: bench_iterativo [expresiones] [terminos]
+
+#include "parser.h"
+#include "bench_util.h"
+
+static double medir(const char *expresion, int expresiones, NodoArbol* (*analizar_fn)(Parser*)) {
+    double inicio = bench_segundos();
+    for (int i = 0; i < expresiones; i++) {
+        Parser *parser = crear_parser(expresion);
+        if (!parser || !analizar_fn(parser)) exit(1);
+        liberar_parser(parser);
+    }
+    return bench_segundos() - inicio;
+}
+
+int main(int argc, char *argv[]) {
+    int expresiones = argc > 1 ? atoi(argv[1]) : 2000;
+    int terminos = argc > 2 ? atoi(argv[2]) : 2000;
+
+    GeneradorBench g = { 99 };
+    TextoBench expr = { NULL, 0, 0 };
+    bench_generar_expresion(&g, &expr, terminos, 32, 4);
+
+    // Alternar el orden reduce el efecto de la caché y de la frecuencia de la CPU
+    double recursivo = medir(expr.datos, expresiones, analizar_recursivo);
+    double iterativo = medir(expr.datos, expresiones, analizar);
+    recursivo = (recursivo + medir(expr.datos, expresiones, analizar_recursivo)) / 2;
+    iterativo = (iterativo + medir(expr.datos, expresiones, analizar)) / 2;
+
+    printf("parser=recursivo expresiones=%d terminos=%d ns_por_expresion=%.0f\n",
+           expresiones, terminos, recursivo * 1e9 / expresiones);
+    printf("parser=iterativo expresiones=%d terminos=%d ns_por_expresion=%.0f\n",
+           expresiones, terminos, iterativo * 1e9 / expresiones);
+
+    free(expr.datos);
+    return 0;
+}
@@ -0,0 +1,130 @@
+// Benchmark: evaluación de una expresión con muchos juegos de valores
+// recorriendo el árbol, con el bytecode y con el código nativo del JIT, más
+// el tiempo de compilación de cada uno. Con "dag" el parser comparte los
+// subárboles repetidos y el JIT calcula cada uno una sola vez.
+// Los tres modos deben dar exactamente el mismo resultado.
+// Uso: bench_jit [operandos_por_caso]
+
+#include "jit.h"
+#include "bench_util.h"
+
+// Evaluación directa del árbol, como en bench_bytecode
+static double evaluar_arbol(const NodoArbol *nodo, const double *valores, const int *variable_de_simbolo) {
+    switch (nodo->tipo) {
+        case NODO_IDENTIFICADOR:
+            return valores[variable_de_simbolo[nodo->simbolo]];
+        case NODO_PARENTESIS:
+            return evaluar_arbol(nodo->izquierdo, valores, variable_de_simbolo);
+        case NODO_SUMA:
+            return evaluar_arbol(nodo->izquierdo, valores, variable_de_simbolo) +
+                   evaluar_arbol(nodo->derecho, valores, variable_de_simbolo);
+        default:
+            return evaluar_arbol(nodo->izquierdo, valores, variable_de_simbolo) *
+                   evaluar_arbol(nodo->derecho, valores, variable_de_simbolo);
+    }
+}
+
+static void medir(int terminos, int compartir, long evaluaciones) {
+    GeneradorBench g = { 5 };
+    TextoBench expr = { NULL, 0, 0 };
+    // Con identificadores de una letra se repiten muchos subárboles
+    bench_generar_expresion(&g, &expr, terminos, 8, compartir ? 1 : 2);
+
+    Parser *parser = crear_parser(expr.datos);
+    if (!parser) exit(1);
+    parser->compartir_nodos = compartir;
+    NodoArbol *arbol = analizar(parser);
+    if (!arbol) exit(1);
+
+    // Latencia de compilación: media de varias compilaciones
+    int repeticiones = 200000 / terminos + 1;
+    Programa programa;
+    double inicio = bench_segundos();
+    for (int i = 0; i < repeticiones; i++) {
+        if (!programa_compilar(&programa, arbol)) exit(1);
+        programa_liberar(&programa);
+    }
+    double segundos_bytecode = (bench_segundos() - inicio) / repeticiones;
+    FuncionJit funcion;
+    inicio = bench_segundos();
+    for (int i = 0; i < repeticiones; i++) {
+        if (!jit_compilar(&funcion, arbol)) exit(1);
+        jit_liberar(&funcion);
+    }
+    double segundos_jit = (bench_segundos() - inicio) / repeticiones;
+
+    if (!programa_compilar(&programa, arbol) || !jit_compilar(&funcion, arbol)) exit(1);
+    uint32_t num_variables = programa.variables.num_simbolos;
+    int *variable_de_simbolo = (int*)malloc(parser->simbolos->num_simbolos * sizeof(int));
+    for (uint32_t s = 0; s < parser->simbolos->num_simbolos; s++) {
+        variable_de_simbolo[s] = programa_variable(&programa, simbolos_nombre(parser->simbolos, s));
+    }
+
+    // Juegos de valores en [0.5, 1.5): los productos largos no se desbordan
+    int num_juegos = 1024;
+    double *valores = (double*)malloc((size_t)num_juegos * num_variables * sizeof(double));
+    for (size_t i = 0; i < (size_t)num_juegos * num_variables; i++) {
+        valores[i] = 0.5 + (double)(bench_aleatorio(&g) % 1000000) / 1e6;
+    }
+    for (int j = 0; j < num_juegos; j++) {
+        const double *juego = valores + (size_t)j * num_variables;
+        double esperado = evaluar_arbol(arbol, juego, variable_de_simbolo);
+        if (programa_evaluar(&programa, juego) != esperado || jit_evaluar(&funcion, juego) != esperado) {
+            fprintf(stderr, "Error: el JIT, el bytecode y el árbol no dan el mismo resultado\n");
+            exit(1);
+        }
+    }
+
+    // Evitar que el compilador descarte las evaluaciones
+    volatile double suma = 0.0;
+
+    inicio = bench_segundos();
+    for (long i = 0; i < evaluaciones; i++) {
+        suma += evaluar_arbol(arbol, valores + (size_t)(i % num_juegos) * num_variables, variable_de_simbolo);
+    }
+    double ns_arbol = (bench_segundos() - inicio) * 1e9 / evaluaciones;
+
+    inicio = bench_segundos();
+    for (long i = 0; i < evaluaciones; i++) {
+        suma += programa_evaluar(&programa, valores + (size_t)(i % num_juegos) * num_variables);
+    }
+    double ns_bytecode = (bench_segundos() - inicio) * 1e9 / evaluaciones;
+
+    inicio = bench_segundos();
+    for (long i = 0; i < evaluaciones; i++) {
+        suma += jit_evaluar(&funcion, valores + (size_t)(i % num_juegos) * num_variables);
+    }
+    double ns_jit = (bench_segundos() - inicio) * 1e9 / evaluaciones;
+
+    const char *forma = compartir ? "dag" : "arbol";
+    printf("modo=arbol forma=%s terminos=%d evaluaciones=%ld ns_por_evaluacion=%.1f\n",
+           forma, terminos, evaluaciones, ns_arbol);
+    printf("modo=bytecode forma=%s terminos=%d instrucciones=%u us_compilacion=%.2f ns_por_evaluacion=%.1f "
+           "aceleracion=%.2f\n", forma, terminos, programa.num_instrucciones, segundos_bytecode * 1e6,
+           ns_bytecode, ns_arbol / ns_bytecode);
+    printf("modo=jit forma=%s terminos=%d nativo=%d bytes_codigo=%zu subexpresiones=%u derrames=%u "
+           "us_compilacion=%.2f ns_por_evaluacion=%.1f aceleracion=%.2f evaluaciones_para_amortizar=%.0f\n",
+           forma, terminos, funcion.nativa != NULL, funcion.tamano_codigo, funcion.subexpresiones,
+           funcion.derrames, segundos_jit * 1e6, ns_jit, ns_arbol / ns_jit,
+           ns_arbol > ns_jit ? segundos_jit * 1e9 / (ns_arbol - ns_jit) : 0.0);
+
+    free(valores);
+    free(variable_de_simbolo);
+    jit_liberar(&funcion);
+    programa_liberar(&programa);
+    liberar_parser(parser);
+    free(expr.datos);
+}
+
+int main(int argc, char *argv[]) {
+    // Misma cantidad de operandos evaluados en cada caso
+    long operandos = argc > 1 ? atol(argv[1]) : 50000000L;
+
+    static const int terminos[] = { 8, 64, 1024, 16384 };
+    for (int compartir = 0; compartir <= 1; compartir++) {
+        for (size_t i = 0; i < sizeof(terminos) / sizeof(terminos[0]); i++) {
+            medir(terminos[i], compartir, operandos / terminos[i]);
+        }
+    }
+    return 0;
+}
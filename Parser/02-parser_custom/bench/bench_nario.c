@@ -0,0 +1,158 @@
+// Benchmark: árbol binario del parser frente a su forma n-aria. Mide la
+// profundidad, la memoria de los nodos, el tiempo de conversión y el de un
+// recorrido completo (con pila explícita en los dos casos).
+// Uso: bench_nario [terminos]
+
+#include "nario.h"
+#include "bench_util.h"
+
+// Recorre el árbol binario; devuelve la suma de los símbolos de las hojas
+// y deja en *profundidad la del árbol (sin contar paréntesis)
+static unsigned long recorrer_binario(const NodoArbol *raiz, uint32_t *profundidad) {
+    typedef struct { const NodoArbol *nodo; uint32_t nivel; } Elemento;
+    size_t capacidad = 64, cantidad = 0;
+    Elemento *pila = (Elemento*)malloc(capacidad * sizeof(Elemento));
+    unsigned long suma = 0;
+    *profundidad = 0;
+    pila[cantidad].nodo = raiz;
+    pila[cantidad].nivel = 1;
+    cantidad++;
+    while (cantidad > 0) {
+        Elemento actual = pila[--cantidad];
+        while (actual.nodo->tipo == NODO_PARENTESIS) {
+            actual.nodo = actual.nodo->izquierdo;
+        }
+        if (actual.nivel > *profundidad) {
+            *profundidad = actual.nivel;
+        }
+        if (actual.nodo->tipo == NODO_IDENTIFICADOR) {
+            suma += actual.nodo->simbolo;
+            continue;
+        }
+        if (cantidad + 2 > capacidad) {
+            capacidad *= 2;
+            pila = (Elemento*)realloc(pila, capacidad * sizeof(Elemento));
+        }
+        pila[cantidad].nodo = actual.nodo->derecho;
+        pila[cantidad].nivel = actual.nivel + 1;
+        cantidad++;
+        pila[cantidad].nodo = actual.nodo->izquierdo;
+        pila[cantidad].nivel = actual.nivel + 1;
+        cantidad++;
+    }
+    free(pila);
+    return suma;
+}
+
+// El mismo recorrido sobre la forma n-aria: los operandos de cada nodo se
+// leen en un solo tramo de 'hijos'
+static unsigned long recorrer_nario(const ArbolNario *nario) {
+    size_t capacidad = 64, cantidad = 0;
+    uint32_t *pila = (uint32_t*)malloc(capacidad * sizeof(uint32_t));
+    unsigned long suma = 0;
+    pila[cantidad++] = 0;
+    while (cantidad > 0) {
+        const NodoNario *actual = &nario->nodos[pila[--cantidad]];
+        if (actual->num_hijos == 0) {
+            suma += actual->simbolo;
+            continue;
+        }
+        if (cantidad + actual->num_hijos > capacidad) {
+            while (cantidad + actual->num_hijos > capacidad) capacidad *= 2;
+            pila = (uint32_t*)realloc(pila, capacidad * sizeof(uint32_t));
+        }
+        memcpy(pila + cantidad, nario->hijos + actual->primer_hijo, actual->num_hijos * sizeof(uint32_t));
+        cantidad += actual->num_hijos;
+    }
+    free(pila);
+    return suma;
+}
+
+static void medir(const char *caso, const char *texto) {
+    Parser *parser = crear_parser(texto);
+    NodoArbol *arbol = parser ? analizar(parser) : NULL;
+    if (!arbol) exit(1);
+
+    uint32_t profundidad_binaria;
+    size_t nodos_binarios = 0;
+    {
+        // Nodos del árbol binario (incluidos los paréntesis)
+        size_t capacidad = 64, cantidad = 0;
+        const NodoArbol **pila = (const NodoArbol**)malloc(capacidad * sizeof(*pila));
+        pila[cantidad++] = arbol;
+        while (cantidad > 0) {
+            const NodoArbol *nodo = pila[--cantidad];
+            nodos_binarios++;
+            if (cantidad + 2 > capacidad) {
+                capacidad *= 2;
+                pila = (const NodoArbol**)realloc(pila, capacidad * sizeof(*pila));
+            }
+            if (nodo->derecho) pila[cantidad++] = nodo->derecho;
+            if (nodo->izquierdo) pila[cantidad++] = nodo->izquierdo;
+        }
+        free(pila);
+    }
+
+    // La primera conversión incluye hacer crecer los arreglos; las
+    // siguientes reutilizan su capacidad
+    int repeticiones = 20;
+    ArbolNario nario;
+    nario_iniciar(&nario);
+    double inicio = bench_segundos();
+    if (!nario_desde_arbol(&nario, arbol, 1)) exit(1);
+    double segundos_primera = bench_segundos() - inicio;
+    inicio = bench_segundos();
+    for (int i = 0; i < repeticiones; i++) {
+        if (!nario_desde_arbol(&nario, arbol, 1)) exit(1);
+    }
+    double segundos_conversion = (bench_segundos() - inicio) / repeticiones;
+
+    unsigned long suma_binaria = 0, suma_naria = 0;
+    inicio = bench_segundos();
+    for (int i = 0; i < repeticiones; i++) {
+        suma_binaria += recorrer_binario(arbol, &profundidad_binaria);
+    }
+    double segundos_binario = (bench_segundos() - inicio) / repeticiones;
+    inicio = bench_segundos();
+    for (int i = 0; i < repeticiones; i++) {
+        suma_naria += recorrer_nario(&nario);
+    }
+    double segundos_nario = (bench_segundos() - inicio) / repeticiones;
+    if (suma_binaria != suma_naria) {
+        fprintf(stderr, "Error: los dos recorridos no visitan las mismas hojas\n");
+        exit(1);
+    }
+
+    printf("caso=%s forma=binaria nodos=%zu profundidad=%u bytes=%zu ms_recorrido=%.2f\n", caso,
+           nodos_binarios, profundidad_binaria, nodos_binarios * sizeof(NodoArbol), segundos_binario * 1e3);
+    printf("caso=%s forma=naria nodos=%u profundidad=%u bytes=%zu ms_primera_conversion=%.2f "
+           "ms_conversion=%.2f ms_recorrido=%.2f "
+           "aceleracion=%.2f\n", caso, nario.num_nodos, nario.profundidad,
+           nario.num_nodos * sizeof(NodoNario) + nario.num_hijos * sizeof(uint32_t),
+           segundos_primera * 1e3, segundos_conversion * 1e3, segundos_nario * 1e3, segundos_binario / segundos_nario);
+
+    nario_liberar(&nario);
+    liberar_parser(parser);
+}
+
+int main(int argc, char *argv[]) {
+    int terminos = argc > 1 ? atoi(argv[1]) : 1000000;
+    GeneradorBench g = { 19 };
+
+    // Una sola suma: el árbol binario tiene tantos niveles como términos
+    TextoBench suma = { NULL, 0, 0 };
+    for (int i = 0; i < terminos; i++) {
+        char ident[4] = { (char)('a' + bench_aleatorio(&g) % 26), (char)('a' + bench_aleatorio(&g) % 26), 0, 0 };
+        if (i > 0) bench_agregar(&suma, " + ", 3);
+        bench_agregar(&suma, ident, 2);
+    }
+    medir("suma", suma.datos);
+    free(suma.datos);
+
+    // Expresión mezclada con paréntesis
+    TextoBench mezcla = { NULL, 0, 0 };
+    bench_generar_expresion(&g, &mezcla, terminos, 8, 2);
+    medir("mezcla", mezcla.datos);
+    free(mezcla.datos);
+    return 0;
+}
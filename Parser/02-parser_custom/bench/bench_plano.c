@@ -0,0 +1,100 @@
+// Benchmark: recorrido del árbol enlazado por punteros frente al arreglo
+// plano, y guardado/mapeo del formato binario.
+// Uso: bench_plano [terminos] [repeticiones]
+
+#include "plano.h"
+#include "bench_util.h"
+
+#define ARCHIVO_BENCH "bench_plano.ast.tmp"
+
+// Cuenta identificadores siguiendo los punteros (pila explícita)
+static long contar_arbol(NodoArbol *raiz) {
+    long identificadores = 0;
+    int capacidad = 64, cantidad = 0;
+    NodoArbol **pila = (NodoArbol**)malloc(capacidad * sizeof(NodoArbol*));
+    pila[cantidad++] = raiz;
+    while (cantidad > 0) {
+        NodoArbol *nodo = pila[--cantidad];
+        identificadores += nodo->tipo == NODO_IDENTIFICADOR;
+        if (cantidad + 2 > capacidad) {
+            capacidad *= 2;
+            pila = (NodoArbol**)realloc(pila, capacidad * sizeof(NodoArbol*));
+        }
+        if (nodo->derecho) pila[cantidad++] = nodo->derecho;
+        if (nodo->izquierdo) pila[cantidad++] = nodo->izquierdo;
+    }
+    free(pila);
+    return identificadores;
+}
+
+// En el arreglo plano basta un recorrido secuencial
+static long contar_plano(const ArbolPlano *plano) {
+    long identificadores = 0;
+    for (uint32_t i = 0; i < plano->num_nodos; i++) {
+        identificadores += plano->nodos[i].tipo == NODO_IDENTIFICADOR;
+    }
+    return identificadores;
+}
+
+int main(int argc, char *argv[]) {
+    int terminos = argc > 1 ? atoi(argv[1]) : 500000;
+    int repeticiones = argc > 2 ? atoi(argv[2]) : 20;
+
+    GeneradorBench g = { 3 };
+    TextoBench expr = { NULL, 0, 0 };
+    bench_generar_expresion(&g, &expr, terminos, 8, 4);
+
+    // El árbol se crea con malloc por nodo, como un árbol construido poco a poco
+    Parser *parser = crear_parser(expr.datos);
+    if (!parser) return 1;
+    parser->usar_arena = 0;
+    NodoArbol *arbol = analizar(parser);
+    if (!arbol) return 1;
+
+    ArbolPlano plano;
+    plano_iniciar(&plano);
+    double inicio = bench_segundos();
+    if (!plano_desde_arbol(&plano, arbol)) return 1;
+    double conversion = bench_segundos() - inicio;
+
+    long control_arbol = 0, control_plano = 0;
+    inicio = bench_segundos();
+    for (int i = 0; i < repeticiones; i++) control_arbol += contar_arbol(arbol);
+    double recorrido_arbol = (bench_segundos() - inicio) / repeticiones;
+    inicio = bench_segundos();
+    for (int i = 0; i < repeticiones; i++) control_plano += contar_plano(&plano);
+    double recorrido_plano = (bench_segundos() - inicio) / repeticiones;
+    if (control_arbol != control_plano) {
+        fprintf(stderr, "Error: los recorridos no coinciden\n");
+        return 1;
+    }
+
+    inicio = bench_segundos();
+    if (!plano_guardar(&plano, ARCHIVO_BENCH)) return 1;
+    double guardado = bench_segundos() - inicio;
+
+    ArbolPlano mapeado;
+    inicio = bench_segundos();
+    if (!plano_mapear(&mapeado, ARCHIVO_BENCH)) return 1;
+    double mapeo = bench_segundos() - inicio;
+    inicio = bench_segundos();
+    long control_mapeado = contar_plano(&mapeado);
+    double primer_recorrido = bench_segundos() - inicio;
+    if (control_mapeado * repeticiones != control_plano) return 1;
+
+    printf("nodos=%u bytes_nodo_arbol=%zu bytes_nodo_plano=%zu\n",
+           plano.num_nodos, sizeof(NodoArbol), sizeof(NodoPlano));
+    printf("prueba=recorrido representacion=arbol ms=%.3f\n", recorrido_arbol * 1e3);
+    printf("prueba=recorrido representacion=plano ms=%.3f\n", recorrido_plano * 1e3);
+    printf("prueba=conversion ms=%.3f\n", conversion * 1e3);
+    printf("prueba=guardado ms=%.3f bytes=%zu\n", guardado * 1e3, mapeado.tamano_mapa);
+    printf("prueba=mapeo ms=%.3f primer_recorrido_ms=%.3f\n", mapeo * 1e3, primer_recorrido * 1e3);
+
+    plano_liberar(&mapeado);
+    plano_liberar(&plano);
+    remove(ARCHIVO_BENCH);
+    liberar_arbol(arbol);
+    liberar_parser(parser);
+    free(expr.datos);
+    return 0;
+}
@@ -0,0 +1,65 @@
+// Benchmark: costo fijo por expresión corta. Compara crear y liberar un
+// parser por línea (con tabla de símbolos propia o compartida) con un solo
+// parser que se reinicia en cada línea con reiniciar_parser.
+// Uso: bench_reinicio [lineas]
+
+#include "parser.h"
+#include "bench_util.h"
+
+// Expresiones cortas típicas de un lote
+static const char *expresiones[] = {
+    "a", "a + b", "a * b", "(a + b) * c", "a + b * c", "x * (y + z) + w",
+    "(a)", "a + b + c + d", "id1 * id2", "a + )",
+};
+#define NUM_EXPRESIONES (sizeof(expresiones) / sizeof(expresiones[0]))
+
+typedef enum { NUEVO_PROPIO, NUEVO_COMPARTIDO, REINICIADO } Modo;
+
+static void medir(const char *caso, Modo modo, long lineas) {
+    int longitudes[NUM_EXPRESIONES];
+    for (size_t i = 0; i < NUM_EXPRESIONES; i++) {
+        longitudes[i] = (int)strlen(expresiones[i]);
+    }
+
+    TablaSimbolos simbolos;
+    simbolos_iniciar(&simbolos);
+    Parser *reutilizable = modo == REINICIADO ? crear_parser_con_simbolos("", 0, &simbolos) : NULL;
+    long validas = 0;
+    unsigned long nodos = 0;
+
+    double inicio = bench_segundos();
+    for (long i = 0; i < lineas; i++) {
+        size_t k = (size_t)i % NUM_EXPRESIONES;
+        Parser *parser;
+        if (modo == REINICIADO) {
+            parser = reutilizable;
+            reiniciar_parser(parser, expresiones[k], longitudes[k]);
+        } else {
+            parser = crear_parser_con_simbolos(expresiones[k], longitudes[k],
+                                               modo == NUEVO_COMPARTIDO ? &simbolos : NULL);
+        }
+        NodoArbol *arbol = analizar(parser);
+        if (arbol) {
+            validas++;
+            nodos += arbol->tipo;
+        }
+        liberar_arbol(arbol);
+        if (modo != REINICIADO) {
+            liberar_parser(parser);
+        }
+    }
+    double segundos = bench_segundos() - inicio;
+
+    printf("caso=%s lineas=%ld validas=%ld ns_por_linea=%.1f lineas_por_s=%.0f control=%lu\n", caso, lineas,
+           validas, segundos * 1e9 / lineas, lineas / segundos, nodos);
+    liberar_parser(reutilizable);
+    simbolos_liberar(&simbolos);
+}
+
+int main(int argc, char *argv[]) {
+    long lineas = argc > 1 ? atol(argv[1]) : 2000000;
+    medir("nuevo_tabla_propia", NUEVO_PROPIO, lineas);
+    medir("nuevo_tabla_compartida", NUEVO_COMPARTIDO, lineas);
+    medir("reiniciado", REINICIADO, lineas);
+    return 0;
+}
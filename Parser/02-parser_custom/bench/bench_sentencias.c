@@ -0,0 +1,100 @@
+// Benchmark: validación de un archivo grande línea por línea (un parser
+// nuevo por línea o uno reiniciado) frente a una sola pasada de
+// analizar_sentencias sobre todo el archivo. Los tres modos deben encontrar
+// los mismos errores.
+// Uso: bench_sentencias [lineas]
+
+#include "parser.h"
+#include "bench_util.h"
+
+// Cuenta las sentencias válidas de analizar_sentencias
+static void contar_sentencia(void *contexto, const Sentencia *sentencia) {
+    if (sentencia->arbol) {
+        (*(long*)contexto)++;
+    }
+}
+
+// Valida cada línea por separado; devuelve las líneas con error
+static long por_lineas(const TextoBench *corpus, int reiniciar, long *validas) {
+    TablaSimbolos simbolos;
+    simbolos_iniciar(&simbolos);
+    Parser *reutilizable = reiniciar ? crear_parser_con_simbolos("", 0, &simbolos) : NULL;
+    long errores = 0;
+    *validas = 0;
+
+    const char *cursor = corpus->datos;
+    const char *fin = corpus->datos + corpus->longitud;
+    while (cursor < fin) {
+        const char *salto = memchr(cursor, '\n', (size_t)(fin - cursor));
+        int longitud = (int)(salto - cursor);
+        Parser *parser = reutilizable;
+        if (parser) {
+            reiniciar_parser(parser, cursor, longitud);
+        } else {
+            parser = crear_parser_con_simbolos(cursor, longitud, &simbolos);
+        }
+        NodoArbol *arbol = analizar(parser);
+        if (arbol) {
+            (*validas)++;
+        } else {
+            errores++;
+        }
+        liberar_arbol(arbol);
+        if (parser != reutilizable) {
+            liberar_parser(parser);
+        }
+        cursor = salto + 1;
+    }
+
+    liberar_parser(reutilizable);
+    simbolos_liberar(&simbolos);
+    return errores;
+}
+
+int main(int argc, char *argv[]) {
+    long lineas = argc > 1 ? atol(argv[1]) : 500000;
+    GeneradorBench g = { 29 };
+
+    // Expresiones cortas de 1 a 12 términos; una de cada 20 con un error
+    TextoBench corpus = { NULL, 0, 0 };
+    for (long i = 0; i < lineas; i++) {
+        bench_generar_expresion(&g, &corpus, 1 + (int)(bench_aleatorio(&g) % 12), 2, 2);
+        if (bench_aleatorio(&g) % 20 == 0) {
+            bench_agregar(&corpus, " * )", 4);
+        }
+        bench_agregar(&corpus, "\n", 1);
+    }
+
+    long validas_nuevo, validas_reiniciado, validas_archivo = 0, sentencias;
+    double inicio = bench_segundos();
+    long errores_nuevo = por_lineas(&corpus, 0, &validas_nuevo);
+    double segundos_nuevo = bench_segundos() - inicio;
+
+    inicio = bench_segundos();
+    long errores_reiniciado = por_lineas(&corpus, 1, &validas_reiniciado);
+    double segundos_reiniciado = bench_segundos() - inicio;
+
+    inicio = bench_segundos();
+    Parser *parser = crear_parser_n(corpus.datos, (int)corpus.longitud);
+    long errores_archivo = analizar_sentencias(parser, contar_sentencia, &validas_archivo, &sentencias);
+    liberar_parser(parser);
+    double segundos_archivo = bench_segundos() - inicio;
+
+    if (errores_nuevo != errores_archivo || errores_reiniciado != errores_archivo ||
+        validas_nuevo != validas_archivo || sentencias != lineas) {
+        fprintf(stderr, "Error: los modos no coinciden (%ld, %ld y %ld errores)\n",
+                errores_nuevo, errores_reiniciado, errores_archivo);
+        return 1;
+    }
+
+    double mb = corpus.longitud / 1e6;
+    printf("caso=linea_parser_nuevo lineas=%ld errores=%ld ms=%.1f mb_por_s=%.1f\n", lineas, errores_nuevo,
+           segundos_nuevo * 1e3, mb / segundos_nuevo);
+    printf("caso=linea_parser_reiniciado lineas=%ld errores=%ld ms=%.1f mb_por_s=%.1f\n", lineas,
+           errores_reiniciado, segundos_reiniciado * 1e3, mb / segundos_reiniciado);
+    // La aceleración se mide contra el mejor modo por líneas (parser reiniciado)
+    printf("caso=archivo_una_pasada lineas=%ld errores=%ld ms=%.1f mb_por_s=%.1f aceleracion=%.2f\n", lineas,
+           errores_archivo, segundos_archivo * 1e3, mb / segundos_archivo, segundos_reiniciado / segundos_archivo);
+    free(corpus.datos);
+    return 0;
+}
@@ -0,0 +1,92 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+// Utilidades comunes de los benchmarks: reloj, memoria pico y un generador
+// determinista de expresiones para la gramática E/T/F
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+
+static inline double bench_segundos(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Memoria residente pico del proceso en KB
+static inline long bench_rss_pico_kb(void) {
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+#ifdef __APPLE__
+    return uso.ru_maxrss / 1024;
+#else
+    return uso.ru_maxrss;
+#endif
+}
+
+// Generador congruencial lineal: misma semilla, mismo corpus
+typedef struct {
+    unsigned long long estado;
+} GeneradorBench;
+
+static inline unsigned int bench_aleatorio(GeneradorBench *g) {
+    g->estado = g->estado * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (unsigned int)(g->estado >> 33);
+}
+
+// Buffer de texto que crece según se necesite
+typedef struct {
+    char *datos;
+    size_t longitud;
+    size_t capacidad;
+} TextoBench;
+
+static inline void bench_agregar(TextoBench *t, const char *s, size_t n) {
+    if (t->longitud + n + 1 > t->capacidad) {
+        t->capacidad = (t->longitud + n + 1) * 2;
+        t->datos = (char*)realloc(t->datos, t->capacidad);
+        if (!t->datos) {
+            fprintf(stderr, "Error: sin memoria para el corpus\n");
+            exit(1);
+        }
+    }
+    memcpy(t->datos + t->longitud, s, n);
+    t->longitud += n;
+    t->datos[t->longitud] = '\0';
+}
+
+// Genera una expresión con 'terminos' operandos; los paréntesis se abren con
+// probabilidad 1/8 mientras la profundidad sea menor que 'profundidad_max'
+static inline void bench_generar_expresion(GeneradorBench *g, TextoBench *t, int terminos,
+                                           int profundidad_max, int longitud_ident) {
+    int abiertos = 0;
+    char ident[64];
+    if (longitud_ident >= (int)sizeof(ident)) longitud_ident = (int)sizeof(ident) - 1;
+
+    for (int i = 0; i < terminos; i++) {
+        if (i > 0) {
+            bench_agregar(t, (bench_aleatorio(g) % 3 == 0) ? " * " : " + ", 3);
+        }
+        while (abiertos < profundidad_max && bench_aleatorio(g) % 8 == 0) {
+            bench_agregar(t, "(", 1);
+            abiertos++;
+        }
+        ident[0] = (char)('a' + bench_aleatorio(g) % 26);
+        for (int k = 1; k < longitud_ident; k++) {
+            ident[k] = (char)('a' + bench_aleatorio(g) % 26);
+        }
+        bench_agregar(t, ident, (size_t)longitud_ident);
+        if (abiertos > 0 && bench_aleatorio(g) % 4 == 0) {
+            bench_agregar(t, ")", 1);
+            abiertos--;
+        }
+    }
+    while (abiertos-- > 0) {
+        bench_agregar(t, ")", 1);
+    }
+}
+
+#endif // BENCH_UTIL_H
@@ -0,0 +1,254 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bytecode.h"
+
+// Con GCC y Clang la máquina virtual salta directamente a la etiqueta de la
+// siguiente instrucción (goto calculado): cada instrucción tiene su propio
+// salto indirecto, que el predictor aprende por separado. En el resto de los
+// compiladores (o con -DSIN_DESPACHO_COMPUTADO) se usa un switch en un bucle
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(SIN_DESPACHO_COMPUTADO)
+#define DESPACHO_COMPUTADO 1
+#endif
+
+// Pila de evaluación en la pila del hilo; las expresiones más anidadas
+// usan memoria dinámica
+#define PILA_LOCAL 256
+
+static int emitir(Programa *programa, CodigoOperacion operacion, uint32_t operando) {
+    if (programa->num_instrucciones == programa->capacidad) {
+        uint32_t capacidad = programa->capacidad ? programa->capacidad * 2 : 64;
+        Instruccion *codigo = (Instruccion*)realloc(programa->codigo, capacidad * sizeof(Instruccion));
+        if (!codigo) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para el bytecode\n");
+            return 0;
+        }
+        programa->codigo = codigo;
+        programa->capacidad = capacidad;
+    }
+    programa->codigo[programa->num_instrucciones++] = (Instruccion)operacion | (operando << 8);
+    return 1;
+}
+
+// Los paréntesis solo agrupan: no generan código
+static const NodoArbol* sin_parentesis(const NodoArbol *nodo) {
+    while (nodo->tipo == NODO_PARENTESIS) {
+        nodo = nodo->izquierdo;
+    }
+    return nodo;
+}
+
+// Índice de la variable del identificador 'nodo' (o SIMBOLO_NINGUNO)
+static Simbolo variable_de(Programa *programa, const NodoArbol *nodo) {
+    Simbolo variable = simbolos_internar(&programa->variables, nodo->valor, strlen(nodo->valor));
+    if (variable != SIMBOLO_NINGUNO && variable >= BYTECODE_MAX_VARIABLES) {
+        fprintf(stderr, "Error: La expresión tiene más de %u variables\n", BYTECODE_MAX_VARIABLES);
+        return SIMBOLO_NINGUNO;
+    }
+    return variable;
+}
+
+// Elemento pendiente de la compilación en postorden
+typedef struct {
+    const NodoArbol *nodo;
+    int paso; // 0: sin compilar, 1: izquierdo compilado
+} PendienteCompilacion;
+
+int programa_compilar(Programa *programa, const NodoArbol *raiz) {
+    programa->codigo = NULL;
+    programa->num_instrucciones = 0;
+    programa->capacidad = 0;
+    programa->max_pila = 0;
+    simbolos_iniciar(&programa->variables);
+
+    int capacidad = 64, cantidad = 0;
+    PendienteCompilacion *pila = (PendienteCompilacion*)malloc(capacidad * sizeof(PendienteCompilacion));
+    if (!pila) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para compilar el árbol\n");
+        return 0;
+    }
+    pila[cantidad].nodo = sin_parentesis(raiz);
+    pila[cantidad].paso = 0;
+    cantidad++;
+
+    // 'profundidad' sigue la altura de la pila de la máquina virtual
+    uint32_t profundidad = 0;
+    int correcto = 1;
+    while (cantidad > 0 && correcto) {
+        PendienteCompilacion *actual = &pila[cantidad - 1];
+        const NodoArbol *nodo = actual->nodo;
+        const NodoArbol *hijo = NULL;
+
+        if (nodo->tipo == NODO_IDENTIFICADOR) {
+            Simbolo variable = variable_de(programa, nodo);
+            correcto = variable != SIMBOLO_NINGUNO && emitir(programa, OP_CARGAR, variable);
+            if (++profundidad > programa->max_pila) {
+                programa->max_pila = profundidad;
+            }
+            cantidad--;
+        } else if (nodo->tipo != NODO_SUMA && nodo->tipo != NODO_MULTIPLICACION) {
+            fprintf(stderr, "Error: Nodo %s inesperado al compilar el árbol\n",
+                    tipo_nodo_a_string((TipoNodo)nodo->tipo));
+            correcto = 0;
+        } else if (actual->paso == 0) {
+            actual->paso = 1;
+            hijo = sin_parentesis(nodo->izquierdo);
+        } else {
+            // Un operando derecho que es una variable no pasa por la pila
+            // (a + b + c se compila como cargar a, sumar b, sumar c)
+            const NodoArbol *derecho = sin_parentesis(nodo->derecho);
+            int es_suma = nodo->tipo == NODO_SUMA;
+            if (derecho->tipo == NODO_IDENTIFICADOR && actual->paso == 1) {
+                Simbolo variable = variable_de(programa, derecho);
+                correcto = variable != SIMBOLO_NINGUNO &&
+                           emitir(programa, es_suma ? OP_SUMAR_VARIABLE : OP_MULTIPLICAR_VARIABLE, variable);
+                cantidad--;
+            } else if (actual->paso == 1) {
+                actual->paso = 2;
+                hijo = derecho;
+            } else {
+                correcto = emitir(programa, es_suma ? OP_SUMAR : OP_MULTIPLICAR, 0);
+                profundidad--;
+                cantidad--;
+            }
+        }
+
+        if (hijo) {
+            if (cantidad == capacidad) {
+                capacidad *= 2;
+                PendienteCompilacion *nueva = (PendienteCompilacion*)realloc(pila, capacidad * sizeof(PendienteCompilacion));
+                if (!nueva) {
+                    fprintf(stderr, "Error: No se pudo asignar memoria para compilar el árbol\n");
+                    correcto = 0;
+                    break;
+                }
+                pila = nueva;
+            }
+            pila[cantidad].nodo = hijo;
+            pila[cantidad].paso = 0;
+            cantidad++;
+        }
+    }
+    free(pila);
+
+    if (!correcto || !emitir(programa, OP_FIN, 0)) {
+        programa_liberar(programa);
+        return 0;
+    }
+    return 1;
+}
+
+void programa_liberar(Programa *programa) {
+    free(programa->codigo);
+    programa->codigo = NULL;
+    programa->num_instrucciones = 0;
+    programa->capacidad = 0;
+    simbolos_liberar(&programa->variables);
+}
+
+int programa_variable(const Programa *programa, const char *nombre) {
+    for (uint32_t i = 0; i < programa->variables.num_simbolos; i++) {
+        if (strcmp(programa->variables.simbolos[i].nombre, nombre) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// El tope de la pila vive en 'acumulador' (un registro); 'tope' apunta a la
+// siguiente casilla libre de la pila de los demás valores. El primer
+// OP_CARGAR guarda en la pila el acumulador inicial, que no se usa
+double programa_evaluar(const Programa *programa, const double *valores) {
+    double pila_local[PILA_LOCAL];
+    double *pila = pila_local;
+    if (programa->max_pila > PILA_LOCAL) {
+        pila = (double*)malloc(programa->max_pila * sizeof(double));
+        if (!pila) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para la pila de evaluación\n");
+            return NAN;
+        }
+    }
+
+    const Instruccion *ip = programa->codigo;
+    double *tope = pila;
+    double acumulador = 0.0;
+    Instruccion instruccion;
+
+#ifdef DESPACHO_COMPUTADO
+    static const void *etiquetas[] = {
+        [OP_CARGAR] = &&caso_OP_CARGAR,
+        [OP_SUMAR] = &&caso_OP_SUMAR,
+        [OP_MULTIPLICAR] = &&caso_OP_MULTIPLICAR,
+        [OP_SUMAR_VARIABLE] = &&caso_OP_SUMAR_VARIABLE,
+        [OP_MULTIPLICAR_VARIABLE] = &&caso_OP_MULTIPLICAR_VARIABLE,
+        [OP_FIN] = &&caso_OP_FIN
+    };
+#define CASO(operacion) caso_##operacion
+#define DESPACHAR() do { instruccion = *ip++; goto *etiquetas[INSTRUCCION_OPERACION(instruccion)]; } while (0)
+#define INICIO_DESPACHO() DESPACHAR();
+#define FIN_DESPACHO()
+#else
+#define CASO(operacion) case operacion
+#define DESPACHAR() break
+#define INICIO_DESPACHO() for (;;) { instruccion = *ip++; switch (INSTRUCCION_OPERACION(instruccion)) {
+#define FIN_DESPACHO() } }
+#endif
+
+    INICIO_DESPACHO()
+    CASO(OP_CARGAR):
+        *tope++ = acumulador;
+        acumulador = valores[INSTRUCCION_OPERANDO(instruccion)];
+        DESPACHAR();
+    CASO(OP_SUMAR):
+        acumulador = *--tope + acumulador;
+        DESPACHAR();
+    CASO(OP_MULTIPLICAR):
+        acumulador = *--tope * acumulador;
+        DESPACHAR();
+    CASO(OP_SUMAR_VARIABLE):
+        acumulador += valores[INSTRUCCION_OPERANDO(instruccion)];
+        DESPACHAR();
+    CASO(OP_MULTIPLICAR_VARIABLE):
+        acumulador *= valores[INSTRUCCION_OPERANDO(instruccion)];
+        DESPACHAR();
+    CASO(OP_FIN):
+        goto fin;
+    FIN_DESPACHO()
+
+#undef CASO
+#undef DESPACHAR
+#undef INICIO_DESPACHO
+#undef FIN_DESPACHO
+
+fin:
+    if (pila != pila_local) {
+        free(pila);
+    }
+    return acumulador;
+}
+
+static const char* nombre_operacion(CodigoOperacion operacion) {
+    switch (operacion) {
+        case OP_CARGAR: return "cargar";
+        case OP_SUMAR: return "sumar";
+        case OP_MULTIPLICAR: return "multiplicar";
+        case OP_SUMAR_VARIABLE: return "sumar_variable";
+        case OP_MULTIPLICAR_VARIABLE: return "multiplicar_variable";
+        case OP_FIN: return "fin";
+        default: return "?";
+    }
+}
+
+void programa_imprimir(Salida *salida, const Programa *programa) {
+    for (uint32_t i = 0; i < programa->num_instrucciones; i++) {
+        Instruccion instruccion = programa->codigo[i];
+        CodigoOperacion operacion = INSTRUCCION_OPERACION(instruccion);
+        salida_printf(salida, "%4u  %s", i, nombre_operacion(operacion));
+        if (operacion == OP_CARGAR || operacion == OP_SUMAR_VARIABLE || operacion == OP_MULTIPLICAR_VARIABLE) {
+            uint32_t variable = INSTRUCCION_OPERANDO(instruccion);
+            salida_printf(salida, " %u (%s)", variable, simbolos_nombre(&programa->variables, variable));
+        }
+        salida_printf(salida, "\n");
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <stdint.h>
+#include "parser.h"
+
+// Compilación del árbol a un bytecode lineal y máquina virtual de pila que
+// lo evalúa sobre un arreglo de valores (uno por variable). Cada instrucción
+// es una palabra de 32 bits: el código de operación en los 8 bits bajos y el
+// operando (un índice de variable) en los 24 altos
+typedef enum {
+    OP_CARGAR,                // Apila valores[operando]
+    OP_SUMAR,                 // Suma los dos valores del tope
+    OP_MULTIPLICAR,           // Multiplica los dos valores del tope
+    OP_SUMAR_VARIABLE,        // tope += valores[operando]
+    OP_MULTIPLICAR_VARIABLE,  // tope *= valores[operando]
+    OP_FIN                    // Devuelve el tope
+} CodigoOperacion;
+
+typedef uint32_t Instruccion;
+
+#define INSTRUCCION_OPERACION(instruccion) ((CodigoOperacion)((instruccion) & 0xFF))
+#define INSTRUCCION_OPERANDO(instruccion) ((instruccion) >> 8)
+#define BYTECODE_MAX_VARIABLES (1u << 24)
+
+// Programa compilado. Las variables son los identificadores de la
+// expresión, numerados en el orden en que aparecen por primera vez (el
+// índice de cada una es su símbolo en 'variables'). 'max_pila' es la
+// profundidad de pila que necesita la evaluación
+typedef struct {
+    Instruccion *codigo;
+    uint32_t num_instrucciones;
+    uint32_t capacidad;
+    uint32_t max_pila;
+    TablaSimbolos variables;
+} Programa;
+
+// Compila el árbol (o DAG) 'raiz'. Devuelve 0 si falta memoria o si hay
+// más de BYTECODE_MAX_VARIABLES variables
+int programa_compilar(Programa *programa, const NodoArbol *raiz);
+void programa_liberar(Programa *programa);
+
+// Índice de la variable 'nombre' en el arreglo de valores, o -1 si la
+// expresión no la usa
+int programa_variable(const Programa *programa, const char *nombre);
+
+// Evalúa el programa con valores[i] como valor de la variable i. Se puede
+// llamar desde varios hilos a la vez sobre el mismo programa
+double programa_evaluar(const Programa *programa, const double *valores);
+
+// Lista legible de las instrucciones
+void programa_imprimir(Salida *salida, const Programa *programa);
+
+#endif // BYTECODE_H
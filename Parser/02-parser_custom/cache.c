@@ -0,0 +1,440 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include "cache.h"
+
+// Texto normalizado en la pila para las entradas cortas
+#define CLAVE_LOCAL 256
+
+// Entrada de la cache: un solo bloque con la cabecera, los nodos del árbol
+// y, a continuación, la clave, el texto, el mensaje, la salida y los valores
+// de los nodos
+struct EntradaCache {
+    EntradaCache *siguiente_casilla;
+    EntradaCache *anterior;   // Más reciente
+    EntradaCache *siguiente;  // Menos reciente
+    uint64_t hash;
+    size_t tamano;
+    const char *clave;
+    size_t longitud_clave;
+    const char *texto;        // Texto exacto (solo en los errores)
+    size_t longitud_texto;
+    ResultadoCache resultado;
+};
+
+static int es_blanco(unsigned char c) {
+    return c == ' ' || c == '\t' || c == '\n';
+}
+
+// Carácter que puede formar parte de un token más largo (identificadores y
+// cualquier otro carácter que no sea un operador, un paréntesis o un blanco)
+static int es_palabra(unsigned char c) {
+    return !es_blanco(c) && c != '+' && c != '*' && c != '(' && c != ')';
+}
+
+// Copia 'texto' a 'destino' sin los blancos que no separan tokens; el
+// resultado nunca es más largo que el texto
+static size_t normalizar(const char *texto, size_t longitud, char *destino) {
+    size_t n = 0;
+    int blanco = 0;
+    for (size_t i = 0; i < longitud; i++) {
+        unsigned char c = (unsigned char)texto[i];
+        if (es_blanco(c)) {
+            blanco = 1;
+            continue;
+        }
+        if (blanco && n > 0 && es_palabra(c) && es_palabra((unsigned char)destino[n - 1])) {
+            destino[n++] = ' ';
+        }
+        blanco = 0;
+        destino[n++] = (char)c;
+    }
+    return n;
+}
+
+// Hash de 64 bits, ocho bytes por paso
+static uint64_t hash_texto(const char *texto, size_t longitud) {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ longitud;
+    size_t i = 0;
+    for (; i + 8 <= longitud; i += 8) {
+        uint64_t bloque;
+        memcpy(&bloque, texto + i, 8);
+        hash = (hash ^ bloque) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 32;
+    }
+    uint64_t resto = 0;
+    memcpy(&resto, texto + i, longitud - i);
+    hash = (hash ^ resto) * 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 29;
+    return hash;
+}
+
+// Clave normalizada de 'texto' en 'local' o en memoria propia (NULL si falta)
+static char* crear_clave(const char *texto, size_t longitud, char *local, size_t *longitud_clave) {
+    char *clave = longitud <= CLAVE_LOCAL ? local : (char*)malloc(longitud);
+    if (clave) {
+        *longitud_clave = normalizar(texto, longitud, clave);
+    }
+    return clave;
+}
+
+void cache_iniciar(CacheAnalisis *cache, size_t presupuesto, const EmisorArbol *emisor) {
+    cache->emisor = emisor;
+    cache->presupuesto = presupuesto;
+    cache->bytes = 0;
+    cache->casillas = NULL;
+    cache->capacidad_casillas = 0;
+    cache->num_entradas = 0;
+    cache->mas_reciente = NULL;
+    cache->menos_reciente = NULL;
+    cache->aciertos = 0;
+    cache->fallos = 0;
+    cache->desalojos = 0;
+    pthread_mutex_init(&cache->mutex, NULL);
+}
+
+void cache_liberar(CacheAnalisis *cache) {
+    EntradaCache *entrada = cache->mas_reciente;
+    while (entrada) {
+        EntradaCache *siguiente = entrada->siguiente;
+        free(entrada);
+        entrada = siguiente;
+    }
+    free(cache->casillas);
+    pthread_mutex_destroy(&cache->mutex);
+    cache->casillas = NULL;
+    cache->capacidad_casillas = 0;
+    cache->num_entradas = 0;
+    cache->bytes = 0;
+    cache->mas_reciente = NULL;
+    cache->menos_reciente = NULL;
+}
+
+// ===== Lista de uso =====
+
+static void quitar_de_lista(CacheAnalisis *cache, EntradaCache *entrada) {
+    if (entrada->anterior) {
+        entrada->anterior->siguiente = entrada->siguiente;
+    } else {
+        cache->mas_reciente = entrada->siguiente;
+    }
+    if (entrada->siguiente) {
+        entrada->siguiente->anterior = entrada->anterior;
+    } else {
+        cache->menos_reciente = entrada->anterior;
+    }
+}
+
+static void poner_al_frente(CacheAnalisis *cache, EntradaCache *entrada) {
+    entrada->anterior = NULL;
+    entrada->siguiente = cache->mas_reciente;
+    if (cache->mas_reciente) {
+        cache->mas_reciente->anterior = entrada;
+    } else {
+        cache->menos_reciente = entrada;
+    }
+    cache->mas_reciente = entrada;
+}
+
+// Saca 'entrada' de la tabla y de la lista y la libera
+static void eliminar(CacheAnalisis *cache, EntradaCache *entrada) {
+    EntradaCache **enlace = &cache->casillas[entrada->hash & (cache->capacidad_casillas - 1)];
+    while (*enlace != entrada) {
+        enlace = &(*enlace)->siguiente_casilla;
+    }
+    *enlace = entrada->siguiente_casilla;
+    quitar_de_lista(cache, entrada);
+    cache->bytes -= entrada->tamano;
+    cache->num_entradas--;
+    free(entrada);
+}
+
+// ===== Tabla =====
+
+static int crecer_casillas(CacheAnalisis *cache) {
+    uint32_t capacidad = cache->capacidad_casillas ? cache->capacidad_casillas * 2 : 256;
+    EntradaCache **casillas = (EntradaCache**)calloc(capacidad, sizeof(EntradaCache*));
+    if (!casillas) {
+        return 0;
+    }
+    for (EntradaCache *entrada = cache->mas_reciente; entrada; entrada = entrada->siguiente) {
+        EntradaCache **casilla = &casillas[entrada->hash & (capacidad - 1)];
+        entrada->siguiente_casilla = *casilla;
+        *casilla = entrada;
+    }
+    free(cache->casillas);
+    cache->casillas = casillas;
+    cache->capacidad_casillas = capacidad;
+    return 1;
+}
+
+// Entrada con la clave dada (la de un error, solo si además coincide el
+// texto exacto). En *misma_clave queda la que tiene la clave aunque no sirva
+static EntradaCache* buscar_entrada(CacheAnalisis *cache, uint64_t hash, const char *clave, size_t longitud_clave,
+                                    const char *texto, size_t longitud, EntradaCache **misma_clave) {
+    *misma_clave = NULL;
+    if (!cache->casillas) {
+        return NULL;
+    }
+    for (EntradaCache *entrada = cache->casillas[hash & (cache->capacidad_casillas - 1)]; entrada;
+         entrada = entrada->siguiente_casilla) {
+        if (entrada->hash != hash || entrada->longitud_clave != longitud_clave ||
+            memcmp(entrada->clave, clave, longitud_clave) != 0) {
+            continue;
+        }
+        *misma_clave = entrada;
+        if (entrada->resultado.valida ||
+            (entrada->longitud_texto == longitud && memcmp(entrada->texto, texto, longitud) == 0)) {
+            return entrada;
+        }
+        return NULL;
+    }
+    return NULL;
+}
+
+// Busca con el mutex tomado y cuenta el acierto o el fallo
+static EntradaCache* consultar(CacheAnalisis *cache, const char *texto, size_t longitud) {
+    char local[CLAVE_LOCAL];
+    size_t longitud_clave = 0;
+    char *clave = crear_clave(texto, longitud, local, &longitud_clave);
+    if (!clave) {
+        cache->fallos++;
+        return NULL;
+    }
+
+    EntradaCache *misma_clave;
+    EntradaCache *entrada = buscar_entrada(cache, hash_texto(clave, longitud_clave), clave, longitud_clave,
+                                           texto, longitud, &misma_clave);
+    if (entrada) {
+        quitar_de_lista(cache, entrada);
+        poner_al_frente(cache, entrada);
+        cache->aciertos++;
+    } else {
+        cache->fallos++;
+    }
+    if (clave != local) {
+        free(clave);
+    }
+    return entrada;
+}
+
+const ResultadoCache* cache_buscar(CacheAnalisis *cache, const char *texto, size_t longitud) {
+    pthread_mutex_lock(&cache->mutex);
+    EntradaCache *entrada = consultar(cache, texto, longitud);
+    pthread_mutex_unlock(&cache->mutex);
+    return entrada ? &entrada->resultado : NULL;
+}
+
+int cache_reproducir(CacheAnalisis *cache, Salida *salida, const char *texto, size_t longitud, int *valida) {
+    pthread_mutex_lock(&cache->mutex);
+    EntradaCache *entrada = consultar(cache, texto, longitud);
+    if (entrada) {
+        // La salida se copia antes de soltar el mutex: otro hilo podría
+        // desalojar la entrada
+        salida_escribir(salida, entrada->resultado.salida, entrada->resultado.longitud_salida);
+        *valida = entrada->resultado.valida;
+    }
+    pthread_mutex_unlock(&cache->mutex);
+    return entrada != NULL;
+}
+
+// ===== Copia del árbol =====
+
+// Elemento pendiente de la copia en preorden
+typedef struct {
+    const NodoArbol *origen;
+    NodoArbol **enlace;  // Dónde va la dirección de la copia
+} PendienteCopia;
+
+// Cuenta los nodos del árbol y los bytes de sus valores (con el '\0')
+static int medir_arbol(const NodoArbol *raiz, size_t *nodos, size_t *bytes_valores) {
+    *nodos = 0;
+    *bytes_valores = 0;
+    if (!raiz) return 1;
+
+    size_t capacidad = 64, cantidad = 0;
+    const NodoArbol **pila = (const NodoArbol**)malloc(capacidad * sizeof(const NodoArbol*));
+    if (!pila) return 0;
+    pila[cantidad++] = raiz;
+    while (cantidad > 0) {
+        const NodoArbol *nodo = pila[--cantidad];
+        (*nodos)++;
+        if (nodo->valor) {
+            *bytes_valores += strlen(nodo->valor) + 1;
+        }
+        if (cantidad + 2 > capacidad) {
+            capacidad *= 2;
+            const NodoArbol **nueva = (const NodoArbol**)realloc(pila, capacidad * sizeof(const NodoArbol*));
+            if (!nueva) {
+                free(pila);
+                return 0;
+            }
+            pila = nueva;
+        }
+        if (nodo->derecho) pila[cantidad++] = nodo->derecho;
+        if (nodo->izquierdo) pila[cantidad++] = nodo->izquierdo;
+    }
+    free(pila);
+    return 1;
+}
+
+// Copia el árbol en 'nodos' (ya medido) y sus valores a partir de 'valores'
+static int copiar_arbol(const NodoArbol *raiz, NodoArbol *nodos, char *valores, const NodoArbol **copia) {
+    *copia = NULL;
+    if (!raiz) return 1;
+
+    size_t capacidad = 64, cantidad = 0, usados = 0;
+    PendienteCopia *pila = (PendienteCopia*)malloc(capacidad * sizeof(PendienteCopia));
+    if (!pila) return 0;
+    NodoArbol *raiz_copia = NULL;
+    pila[cantidad].origen = raiz;
+    pila[cantidad].enlace = &raiz_copia;
+    cantidad++;
+
+    while (cantidad > 0) {
+        PendienteCopia actual = pila[--cantidad];
+        NodoArbol *nodo = &nodos[usados++];
+        *actual.enlace = nodo;
+        *nodo = *actual.origen;
+        nodo->en_arena = 1;     // liberar_arbol no lo toca: es parte de la entrada
+        nodo->compartido = 0;
+        nodo->simbolo = SIMBOLO_NINGUNO;
+        nodo->izquierdo = NULL;
+        nodo->derecho = NULL;
+        if (actual.origen->valor) {
+            size_t longitud = strlen(actual.origen->valor) + 1;
+            memcpy(valores, actual.origen->valor, longitud);
+            nodo->valor = valores;
+            valores += longitud;
+        }
+
+        if (cantidad + 2 > capacidad) {
+            capacidad *= 2;
+            PendienteCopia *nueva = (PendienteCopia*)realloc(pila, capacidad * sizeof(PendienteCopia));
+            if (!nueva) {
+                free(pila);
+                return 0;
+            }
+            pila = nueva;
+        }
+        if (actual.origen->derecho) {
+            pila[cantidad].origen = actual.origen->derecho;
+            pila[cantidad].enlace = &nodo->derecho;
+            cantidad++;
+        }
+        if (actual.origen->izquierdo) {
+            pila[cantidad].origen = actual.origen->izquierdo;
+            pila[cantidad].enlace = &nodo->izquierdo;
+            cantidad++;
+        }
+    }
+    free(pila);
+    *copia = raiz_copia;
+    return 1;
+}
+
+// ===== Inserción =====
+
+void cache_guardar(CacheAnalisis *cache, const char *texto, size_t longitud, const NodoArbol *arbol,
+                   const char *mensaje_error, const char *salida, size_t longitud_salida) {
+    // Sin emisor (--count) solo hace falta saber si la entrada es válida y
+    // su error: el árbol no se copia
+    int valida = arbol != NULL;
+    if (!cache->emisor) {
+        arbol = NULL;
+    }
+    if (!mensaje_error || valida) {
+        mensaje_error = "";
+    }
+    if (!salida) {
+        longitud_salida = 0;
+    }
+
+    // Todo lo que no depende de la cache se prepara sin el mutex
+    char local[CLAVE_LOCAL];
+    size_t longitud_clave = 0;
+    char *clave = crear_clave(texto, longitud, local, &longitud_clave);
+    size_t nodos = 0, bytes_valores = 0;
+    if (!clave || !medir_arbol(arbol, &nodos, &bytes_valores)) {
+        if (clave && clave != local) free(clave);
+        return;
+    }
+    size_t longitud_texto = valida ? 0 : longitud;
+    size_t longitud_mensaje = strlen(mensaje_error) + 1;
+    size_t tamano = sizeof(EntradaCache) + nodos * sizeof(NodoArbol) + longitud_clave + longitud_texto +
+                    longitud_mensaje + longitud_salida + bytes_valores;
+    EntradaCache *entrada = tamano <= cache->presupuesto ? (EntradaCache*)malloc(tamano) : NULL;
+    if (!entrada) {
+        if (clave != local) free(clave);
+        return;
+    }
+
+    NodoArbol *nodos_copia = (NodoArbol*)(entrada + 1);
+    char *cursor = (char*)(nodos_copia + nodos);
+    entrada->clave = cursor;
+    memcpy(cursor, clave, longitud_clave);
+    cursor += longitud_clave;
+    entrada->longitud_clave = longitud_clave;
+    entrada->texto = cursor;
+    memcpy(cursor, texto, longitud_texto);
+    cursor += longitud_texto;
+    entrada->longitud_texto = longitud_texto;
+    entrada->resultado.mensaje_error = cursor;
+    memcpy(cursor, mensaje_error, longitud_mensaje);
+    cursor += longitud_mensaje;
+    entrada->resultado.salida = cursor;
+    if (longitud_salida) {
+        memcpy(cursor, salida, longitud_salida);
+    }
+    cursor += longitud_salida;
+    entrada->resultado.longitud_salida = longitud_salida;
+    entrada->resultado.valida = valida;
+    entrada->hash = hash_texto(clave, longitud_clave);
+    entrada->tamano = tamano;
+    if (clave != local) free(clave);
+    if (!copiar_arbol(arbol, nodos_copia, cursor, &entrada->resultado.arbol)) {
+        free(entrada);
+        return;
+    }
+
+    pthread_mutex_lock(&cache->mutex);
+    EntradaCache *misma_clave;
+    EntradaCache *existente = buscar_entrada(cache, entrada->hash, entrada->clave, longitud_clave,
+                                             texto, longitud, &misma_clave);
+    if (existente) {
+        // Otro hilo la guardó mientras se analizaba
+        free(entrada);
+        pthread_mutex_unlock(&cache->mutex);
+        return;
+    }
+    if (misma_clave) {
+        // Un error con otros blancos: se reemplaza por el más reciente
+        eliminar(cache, misma_clave);
+    }
+    while (cache->bytes + tamano > cache->presupuesto && cache->menos_reciente) {
+        eliminar(cache, cache->menos_reciente);
+        cache->desalojos++;
+    }
+    if (cache->num_entradas >= cache->capacidad_casillas && !crecer_casillas(cache)) {
+        free(entrada);
+        pthread_mutex_unlock(&cache->mutex);
+        return;
+    }
+    EntradaCache **casilla = &cache->casillas[entrada->hash & (cache->capacidad_casillas - 1)];
+    entrada->siguiente_casilla = *casilla;
+    *casilla = entrada;
+    poner_al_frente(cache, entrada);
+    cache->bytes += tamano;
+    cache->num_entradas++;
+    pthread_mutex_unlock(&cache->mutex);
+}
+
+void cache_imprimir_estadisticas(CacheAnalisis *cache, FILE *destino) {
+    pthread_mutex_lock(&cache->mutex);
+    unsigned long consultas = cache->aciertos + cache->fallos;
+    fprintf(destino, "🗄️  Cache: %lu aciertos, %lu fallos (%.1f%%), %lu desalojos, %u entradas, %.2f de %.2f MB\n",
+            cache->aciertos, cache->fallos, consultas ? 100.0 * cache->aciertos / consultas : 0.0,
+            cache->desalojos, cache->num_entradas, cache->bytes / 1e6, cache->presupuesto / 1e6);
+    pthread_mutex_unlock(&cache->mutex);
+}
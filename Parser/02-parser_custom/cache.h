@@ -0,0 +1,68 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "emisor.h"
+
+// Cache de resultados de análisis para entradas repetidas (LRU con un
+// límite de memoria). La clave es el texto normalizado: los blancos solo se
+// conservan, como un espacio, entre dos caracteres que formarían un mismo
+// token, así que "a+b" y "a + b" comparten entrada. Como el mensaje de un
+// error incluye la columna, un error solo se reutiliza con el texto exacto.
+// Todas las funciones se pueden llamar desde varios hilos
+
+// Resultado guardado de un análisis. El árbol es una copia propia de la
+// cache: sus nodos no tienen símbolo (SIMBOLO_NINGUNO) y los nombres están
+// en 'valor'
+typedef struct {
+    int valida;
+    const NodoArbol *arbol;     // NULL si no es válida o si la cache no tiene emisor
+    const char *mensaje_error;  // Mensaje de reportar_error ("" si es válida)
+    const char *salida;         // Lo que escribió el emisor con 'arbol' o 'error'
+    size_t longitud_salida;
+} ResultadoCache;
+
+typedef struct EntradaCache EntradaCache;
+
+// Tabla hash encadenada más una lista doble en orden de uso: la entrada
+// menos reciente es la primera en salir cuando no alcanza el presupuesto
+typedef struct {
+    const EmisorArbol *emisor;  // Formato de las salidas guardadas (NULL: ninguna)
+    size_t presupuesto;         // Bytes máximos de las entradas
+    size_t bytes;
+    EntradaCache **casillas;
+    uint32_t capacidad_casillas;
+    uint32_t num_entradas;
+    EntradaCache *mas_reciente;
+    EntradaCache *menos_reciente;
+    unsigned long aciertos;
+    unsigned long fallos;
+    unsigned long desalojos;
+    pthread_mutex_t mutex;
+} CacheAnalisis;
+
+// Funciones de la cache
+void cache_iniciar(CacheAnalisis *cache, size_t presupuesto, const EmisorArbol *emisor);
+void cache_liberar(CacheAnalisis *cache);
+
+// Busca 'texto'; el resultado vale hasta la siguiente llamada a
+// cache_guardar (con varios hilos, usar cache_reproducir)
+const ResultadoCache* cache_buscar(CacheAnalisis *cache, const char *texto, size_t longitud);
+
+// Si 'texto' está en la cache, escribe su salida guardada en 'salida', deja
+// en *valida si era válida y devuelve 1
+int cache_reproducir(CacheAnalisis *cache, Salida *salida, const char *texto, size_t longitud, int *valida);
+
+// Guarda el resultado del análisis de 'texto': el árbol (NULL si no es
+// válida), el mensaje de error y lo que escribió el emisor. Si la cache no
+// tiene emisor solo guarda si es válida y el mensaje. No hace nada si la
+// entrada no cabe en el presupuesto
+void cache_guardar(CacheAnalisis *cache, const char *texto, size_t longitud, const NodoArbol *arbol,
+                   const char *mensaje_error, const char *salida, size_t longitud_salida);
+
+// Aciertos, fallos, desalojos y memoria usada, en una línea
+void cache_imprimir_estadisticas(CacheAnalisis *cache, FILE *destino);
+
+#endif // CACHE_H
@@ -0,0 +1,368 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "columnas.h"
+#include "pool.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define COLUMNAS_X86 1
+#include <immintrin.h>
+#endif
+
+// Tramos de filas por hilo al repartir el trabajo (más de uno para que el
+// robo de trabajo equilibre hilos que van a distinta velocidad)
+#define TRAMOS_POR_HILO 4
+
+// ===== Núcleos =====
+// destino[i] = a[i] op b[i]; 'destino' puede ser 'a' o 'b' (mismo índice)
+
+typedef void (*NucleoColumnas)(double *destino, const double *a, const double *b, size_t n);
+
+static void sumar_escalar(double *destino, const double *a, const double *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        destino[i] = a[i] + b[i];
+    }
+}
+
+static void multiplicar_escalar(double *destino, const double *a, const double *b, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        destino[i] = a[i] * b[i];
+    }
+}
+
+#ifdef COLUMNAS_X86
+
+__attribute__((target("sse2")))
+static void sumar_sse2(double *destino, const double *a, const double *b, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128d x0 = _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+        __m128d x1 = _mm_add_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2));
+        _mm_storeu_pd(destino + i, x0);
+        _mm_storeu_pd(destino + i + 2, x1);
+    }
+    sumar_escalar(destino + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("sse2")))
+static void multiplicar_sse2(double *destino, const double *a, const double *b, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128d x0 = _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+        __m128d x1 = _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2));
+        _mm_storeu_pd(destino + i, x0);
+        _mm_storeu_pd(destino + i + 2, x1);
+    }
+    multiplicar_escalar(destino + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void sumar_avx2(double *destino, const double *a, const double *b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d x0 = _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        __m256d x1 = _mm256_add_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+        _mm256_storeu_pd(destino + i, x0);
+        _mm256_storeu_pd(destino + i + 4, x1);
+    }
+    sumar_escalar(destino + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void multiplicar_avx2(double *destino, const double *a, const double *b, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d x0 = _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        __m256d x1 = _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+        _mm256_storeu_pd(destino + i, x0);
+        _mm256_storeu_pd(destino + i + 4, x1);
+    }
+    multiplicar_escalar(destino + i, a + i, b + i, n - i);
+}
+
+#endif // COLUMNAS_X86
+
+// Núcleo activo
+static NucleoColumnas funcion_sumar = 0;
+static NucleoColumnas funcion_multiplicar = 0;
+static KernelColumnas kernel_activo = KERNEL_COLUMNAS_AUTO;
+
+// Como en escaneo.c: con GCC/Clang el núcleo se elige al cargar el
+// programa, antes de que existan hilos
+#ifdef __GNUC__
+__attribute__((constructor))
+static void columnas_inicializar(void) {
+    columnas_seleccionar(KERNEL_COLUMNAS_AUTO);
+}
+#endif
+
+int columnas_seleccionar(KernelColumnas kernel) {
+#ifdef COLUMNAS_X86
+    __builtin_cpu_init();
+    int tiene_sse2 = __builtin_cpu_supports("sse2");
+    int tiene_avx2 = __builtin_cpu_supports("avx2");
+    if (kernel == KERNEL_COLUMNAS_AUTO) {
+        kernel = tiene_avx2 ? KERNEL_COLUMNAS_AVX2 : (tiene_sse2 ? KERNEL_COLUMNAS_SSE2 : KERNEL_COLUMNAS_ESCALAR);
+    }
+    if (kernel == KERNEL_COLUMNAS_AVX2) {
+        if (!tiene_avx2) return 0;
+        funcion_sumar = sumar_avx2;
+        funcion_multiplicar = multiplicar_avx2;
+        kernel_activo = kernel;
+        return 1;
+    }
+    if (kernel == KERNEL_COLUMNAS_SSE2) {
+        if (!tiene_sse2) return 0;
+        funcion_sumar = sumar_sse2;
+        funcion_multiplicar = multiplicar_sse2;
+        kernel_activo = kernel;
+        return 1;
+    }
+#else
+    if (kernel == KERNEL_COLUMNAS_AUTO) {
+        kernel = KERNEL_COLUMNAS_ESCALAR;
+    }
+    if (kernel != KERNEL_COLUMNAS_ESCALAR) {
+        return 0;
+    }
+#endif
+    funcion_sumar = sumar_escalar;
+    funcion_multiplicar = multiplicar_escalar;
+    kernel_activo = KERNEL_COLUMNAS_ESCALAR;
+    return 1;
+}
+
+const char* columnas_nombre_kernel(void) {
+    switch (kernel_activo) {
+        case KERNEL_COLUMNAS_ESCALAR: return "escalar";
+        case KERNEL_COLUMNAS_SSE2: return "sse2";
+        case KERNEL_COLUMNAS_AVX2: return "avx2";
+        default: return "auto";
+    }
+}
+
+// ===== Evaluación por bloques =====
+
+// Memoria de trabajo de un tramo de filas: la pila de punteros a vectores y
+// un vector temporal de un bloque por cada profundidad de la pila
+typedef struct {
+    const double **pila;
+    double **temporales;
+    double *memoria;
+} EspacioColumnas;
+
+static int crear_espacio(EspacioColumnas *espacio, const Programa *programa) {
+    uint32_t niveles = programa->max_pila + 1;
+    espacio->pila = (const double**)malloc(niveles * sizeof(const double*));
+    espacio->temporales = (double**)malloc(niveles * sizeof(double*));
+    // La profundidad 1 escribe en el resultado: no necesita temporal
+    size_t dobles = niveles > 2 ? (size_t)(niveles - 2) * COLUMNAS_FILAS_BLOQUE : 1;
+    espacio->memoria = (double*)malloc(dobles * sizeof(double));
+    if (!espacio->pila || !espacio->temporales || !espacio->memoria) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la evaluación por columnas\n");
+        free(espacio->pila);
+        free(espacio->temporales);
+        free(espacio->memoria);
+        return 0;
+    }
+    for (uint32_t d = 2; d < niveles; d++) {
+        espacio->temporales[d] = espacio->memoria + (size_t)(d - 2) * COLUMNAS_FILAS_BLOQUE;
+    }
+    return 1;
+}
+
+static void liberar_espacio(EspacioColumnas *espacio) {
+    free(espacio->pila);
+    free(espacio->temporales);
+    free(espacio->memoria);
+}
+
+// Evalúa las filas [inicio, inicio + n) con n <= COLUMNAS_FILAS_BLOQUE.
+// Como en programa_evaluar, el tope de la pila es 'acumulador', aquí un
+// puntero a un vector: OP_CARGAR no copia nada, solo apunta a la columna.
+// El resultado de una operación a profundidad d se escribe en
+// temporales[d]; el de profundidad 1 (el valor final) va directo a
+// 'resultado'. Las operaciones se hacen en el mismo orden que en
+// programa_evaluar, así que cada fila da exactamente el mismo valor
+static void evaluar_bloque(const Programa *programa, const double *const *columnas, size_t inicio, size_t n,
+                           EspacioColumnas *espacio, double *resultado) {
+    NucleoColumnas sumar = funcion_sumar;
+    NucleoColumnas multiplicar = funcion_multiplicar;
+    double **temporales = espacio->temporales;
+    const double **tope = espacio->pila;
+    const double *acumulador = NULL;
+    uint32_t profundidad = 0;
+    temporales[1] = resultado + inicio;
+
+    for (const Instruccion *ip = programa->codigo; ; ip++) {
+        Instruccion instruccion = *ip;
+        switch (INSTRUCCION_OPERACION(instruccion)) {
+            case OP_CARGAR:
+                *tope++ = acumulador;
+                profundidad++;
+                acumulador = columnas[INSTRUCCION_OPERANDO(instruccion)] + inicio;
+                break;
+            case OP_SUMAR:
+                profundidad--;
+                sumar(temporales[profundidad], *--tope, acumulador, n);
+                acumulador = temporales[profundidad];
+                break;
+            case OP_MULTIPLICAR:
+                profundidad--;
+                multiplicar(temporales[profundidad], *--tope, acumulador, n);
+                acumulador = temporales[profundidad];
+                break;
+            case OP_SUMAR_VARIABLE:
+                sumar(temporales[profundidad], acumulador, columnas[INSTRUCCION_OPERANDO(instruccion)] + inicio, n);
+                acumulador = temporales[profundidad];
+                break;
+            case OP_MULTIPLICAR_VARIABLE:
+                multiplicar(temporales[profundidad], acumulador,
+                            columnas[INSTRUCCION_OPERANDO(instruccion)] + inicio, n);
+                acumulador = temporales[profundidad];
+                break;
+            case OP_FIN:
+                // Una expresión que es solo una variable no escribió nada
+                if (acumulador != resultado + inicio) {
+                    memcpy(resultado + inicio, acumulador, n * sizeof(double));
+                }
+                return;
+        }
+    }
+}
+
+static void evaluar_filas(const Programa *programa, const double *const *columnas, size_t inicio, size_t fin,
+                          EspacioColumnas *espacio, double *resultado) {
+    for (size_t fila = inicio; fila < fin; fila += COLUMNAS_FILAS_BLOQUE) {
+        size_t n = fin - fila < COLUMNAS_FILAS_BLOQUE ? fin - fila : COLUMNAS_FILAS_BLOQUE;
+        evaluar_bloque(programa, columnas, fila, n, espacio, resultado);
+    }
+}
+
+// ===== Reparto entre hilos =====
+
+// Cada tarea es un tramo de filas con su propio espacio de trabajo (creado
+// antes de lanzar el pool, para que las tareas no puedan fallar)
+typedef struct {
+    const Programa *programa;
+    const double *const *columnas;
+    double *resultado;
+    size_t filas;
+    size_t filas_por_tramo;
+    EspacioColumnas *espacios;
+} TrabajoColumnas;
+
+static void ejecutar_tramo(void *contexto, size_t tramo) {
+    TrabajoColumnas *trabajo = (TrabajoColumnas*)contexto;
+    size_t inicio = tramo * trabajo->filas_por_tramo;
+    size_t fin = inicio + trabajo->filas_por_tramo;
+    if (fin > trabajo->filas) {
+        fin = trabajo->filas;
+    }
+    evaluar_filas(trabajo->programa, trabajo->columnas, inicio, fin, &trabajo->espacios[tramo], trabajo->resultado);
+}
+
+int evaluar_columnas(const Programa *programa, const double *const *columnas, size_t filas,
+                     double *resultado, int hilos) {
+    if (hilos <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        hilos = cpus > 0 ? (int)cpus : 1;
+    }
+
+    // Tramos de bloques enteros; con pocas filas no vale la pena repartir
+    size_t bloques = (filas + COLUMNAS_FILAS_BLOQUE - 1) / COLUMNAS_FILAS_BLOQUE;
+    size_t num_tramos = (size_t)hilos * TRAMOS_POR_HILO;
+    if (num_tramos > bloques / 8) {
+        num_tramos = bloques / 8;
+    }
+    if (hilos == 1 || num_tramos <= 1) {
+        EspacioColumnas espacio;
+        if (!crear_espacio(&espacio, programa)) {
+            return 0;
+        }
+        evaluar_filas(programa, columnas, 0, filas, &espacio, resultado);
+        liberar_espacio(&espacio);
+        return 1;
+    }
+
+    TrabajoColumnas trabajo;
+    trabajo.programa = programa;
+    trabajo.columnas = columnas;
+    trabajo.resultado = resultado;
+    trabajo.filas = filas;
+    trabajo.filas_por_tramo = (bloques + num_tramos - 1) / num_tramos * COLUMNAS_FILAS_BLOQUE;
+    num_tramos = (filas + trabajo.filas_por_tramo - 1) / trabajo.filas_por_tramo;
+    trabajo.espacios = (EspacioColumnas*)malloc(num_tramos * sizeof(EspacioColumnas));
+    if (!trabajo.espacios) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la evaluación por columnas\n");
+        return 0;
+    }
+    size_t creados = 0;
+    while (creados < num_tramos && crear_espacio(&trabajo.espacios[creados], programa)) {
+        creados++;
+    }
+
+    int correcto = creados == num_tramos;
+    if (correcto) {
+        Pool *pool = crear_pool(hilos, ejecutar_tramo, &trabajo);
+        if (pool) {
+            for (size_t tramo = 0; tramo < num_tramos; tramo++) {
+                pool_enviar(pool, tramo);
+            }
+            liberar_pool(pool);
+        } else {
+            // Sin hilos: todo en el hilo actual
+            for (size_t tramo = 0; tramo < num_tramos; tramo++) {
+                ejecutar_tramo(&trabajo, tramo);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < creados; i++) {
+        liberar_espacio(&trabajo.espacios[i]);
+    }
+    free(trabajo.espacios);
+    return correcto;
+}
+
+int evaluar_arbol_columnas(const NodoArbol *raiz, const char *const *nombres, const double *const *columnas,
+                           int num_columnas, size_t filas, double *resultado, int hilos) {
+    Programa programa;
+    if (!programa_compilar(&programa, raiz)) {
+        return 0;
+    }
+
+    // Columna de cada variable del programa
+    uint32_t num_variables = programa.variables.num_simbolos;
+    const double **columnas_programa = (const double**)malloc((num_variables ? num_variables : 1) * sizeof(const double*));
+    if (!columnas_programa) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la evaluación por columnas\n");
+        programa_liberar(&programa);
+        return 0;
+    }
+    int correcto = 1;
+    for (uint32_t v = 0; v < num_variables && correcto; v++) {
+        const char *nombre = simbolos_nombre(&programa.variables, v);
+        columnas_programa[v] = NULL;
+        for (int c = 0; c < num_columnas; c++) {
+            if (strcmp(nombres[c], nombre) == 0) {
+                columnas_programa[v] = columnas[c];
+                break;
+            }
+        }
+        if (!columnas_programa[v]) {
+            fprintf(stderr, "Error: No hay columna para el identificador '%s'\n", nombre);
+            correcto = 0;
+        }
+    }
+
+    if (correcto) {
+        correcto = evaluar_columnas(&programa, columnas_programa, filas, resultado, hilos);
+    }
+    free(columnas_programa);
+    programa_liberar(&programa);
+    return correcto;
+}
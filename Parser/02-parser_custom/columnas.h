@@ -0,0 +1,40 @@
+#ifndef COLUMNAS_H
+#define COLUMNAS_H
+
+#include <stddef.h>
+#include "bytecode.h"
+
+// Evaluación por columnas: una expresión aplicada a todas las filas de una
+// tabla guardada como un arreglo de valores por variable. El bytecode se
+// interpreta una vez por bloque de filas (no una vez por fila) y cada
+// instrucción recorre el bloque entero con un núcleo vectorial; los valores
+// intermedios viven en vectores temporales reutilizados de bloque en bloque,
+// que caben en la caché, así que cada columna se lee de memoria una sola vez
+#define COLUMNAS_FILAS_BLOQUE 1024
+
+// Núcleos de + y * (escalar, SSE2 o AVX2), elegidos en tiempo de ejecución
+typedef enum {
+    KERNEL_COLUMNAS_AUTO,
+    KERNEL_COLUMNAS_ESCALAR,
+    KERNEL_COLUMNAS_SSE2,
+    KERNEL_COLUMNAS_AVX2
+} KernelColumnas;
+
+// Selección del núcleo (devuelve 0 si la CPU no lo admite)
+int columnas_seleccionar(KernelColumnas kernel);
+const char* columnas_nombre_kernel(void);
+
+// Evalúa 'programa' en 'filas' filas: columnas[i] son los valores de la
+// variable i del programa y resultado[f] recibe el valor de la fila f. Con
+// más de un hilo (0: uno por CPU) las filas se reparten en tramos entre los
+// hilos de un pool. Devuelve 0 si falta memoria
+int evaluar_columnas(const Programa *programa, const double *const *columnas, size_t filas,
+                     double *resultado, int hilos);
+
+// Igual, a partir del árbol: nombres[i] es el identificador de columnas[i].
+// Devuelve 0 si falta memoria o si la expresión usa un identificador que no
+// está entre los nombres
+int evaluar_arbol_columnas(const NodoArbol *raiz, const char *const *nombres, const double *const *columnas,
+                           int num_columnas, size_t filas, double *resultado, int hilos);
+
+#endif // COLUMNAS_H
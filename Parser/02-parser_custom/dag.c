@@ -0,0 +1,208 @@
+#include "parser.h"
+
+#define TABLA_NODOS_CASILLAS_INICIALES 256
+
+// Nodo compartido: el nodo del árbol seguido de su hash estructural
+struct NodoCompartido {
+    NodoArbol nodo;
+    uint32_t hash;
+};
+
+// FNV-1a de 32 bits sobre una cadena terminada en '\0'
+static uint32_t hash_cadena(const char *cadena) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char*)cadena; *c; c++) {
+        hash ^= *c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t mezclar(uint32_t hash, uint32_t valor) {
+    hash ^= valor + 0x9e3779b9u + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// Hash de un nodo a partir de los hashes de sus hijos; solo depende de la
+// estructura, no de las direcciones, así que es el mismo entre ejecuciones
+static uint32_t combinar_hash(TipoNodo tipo, const char *valor, uint32_t hash_izq, uint32_t hash_der) {
+    uint32_t hash = mezclar(0, (uint32_t)tipo + 1);
+    hash = mezclar(hash, valor ? hash_cadena(valor) : 0);
+    hash = mezclar(hash, hash_izq);
+    hash = mezclar(hash, hash_der);
+    return hash;
+}
+
+static int mismo_valor(const char *a, const char *b) {
+    if (a == b) return 1;
+    if (!a || !b) return 0;
+    return strcmp(a, b) == 0;
+}
+
+void tabla_nodos_iniciar(TablaNodos *tabla) {
+    tabla->casillas = NULL;
+    tabla->capacidad_casillas = 0;
+    tabla->num_nodos = 0;
+}
+
+// Los nodos viven en la arena del parser; aquí solo se liberan las casillas
+void tabla_nodos_liberar(TablaNodos *tabla) {
+    free(tabla->casillas);
+    tabla_nodos_iniciar(tabla);
+}
+
+// Para reutilizar la tabla con otra entrada (los nodos ya se descartaron
+// con la arena)
+void tabla_nodos_vaciar(TablaNodos *tabla) {
+    if (tabla->casillas && tabla->num_nodos > 0) {
+        memset(tabla->casillas, 0, tabla->capacidad_casillas * sizeof(NodoCompartido*));
+    }
+    tabla->num_nodos = 0;
+}
+
+static int crecer_casillas(TablaNodos *tabla) {
+    uint32_t capacidad = tabla->capacidad_casillas ? tabla->capacidad_casillas * 2 : TABLA_NODOS_CASILLAS_INICIALES;
+    NodoCompartido **casillas = (NodoCompartido**)calloc(capacidad, sizeof(NodoCompartido*));
+    if (!casillas) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la tabla de nodos\n");
+        return 0;
+    }
+
+    uint32_t mascara = capacidad - 1;
+    for (uint32_t i = 0; i < tabla->capacidad_casillas; i++) {
+        NodoCompartido *compartido = tabla->casillas[i];
+        if (!compartido) continue;
+        uint32_t casilla = compartido->hash & mascara;
+        while (casillas[casilla]) {
+            casilla = (casilla + 1) & mascara;
+        }
+        casillas[casilla] = compartido;
+    }
+
+    free(tabla->casillas);
+    tabla->casillas = casillas;
+    tabla->capacidad_casillas = capacidad;
+    return 1;
+}
+
+// Devuelve el nodo igual ya existente o crea uno nuevo en la arena.
+// Los hijos deben ser nodos compartidos de la misma tabla
+NodoArbol* crear_nodo_compartido(TablaNodos *tabla, Arena *arena, TipoNodo tipo, const char *valor,
+                                 Simbolo simbolo, NodoArbol *izq, NodoArbol *der, int linea, int columna) {
+    if ((tabla->num_nodos + 1) * 2 > tabla->capacidad_casillas && !crecer_casillas(tabla)) {
+        return NULL;
+    }
+
+    uint32_t hash = combinar_hash(tipo, valor, izq ? hash_estructural(izq) : 0, der ? hash_estructural(der) : 0);
+    uint32_t mascara = tabla->capacidad_casillas - 1;
+    uint32_t casilla = hash & mascara;
+
+    // Como los hijos ya son únicos, basta comparar sus direcciones
+    while (tabla->casillas[casilla]) {
+        NodoCompartido *compartido = tabla->casillas[casilla];
+        NodoArbol *nodo = &compartido->nodo;
+        if (compartido->hash == hash && nodo->tipo == tipo && nodo->simbolo == simbolo &&
+            nodo->izquierdo == izq && nodo->derecho == der && mismo_valor(nodo->valor, valor)) {
+            return nodo;
+        }
+        casilla = (casilla + 1) & mascara;
+    }
+
+    NodoCompartido *compartido = (NodoCompartido*)arena_asignar(arena, sizeof(NodoCompartido));
+    if (!compartido) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el nodo\n");
+        return NULL;
+    }
+
+    NodoArbol *nodo = &compartido->nodo;
+    nodo->tipo = (unsigned char)tipo;
+    nodo->en_arena = 1;
+    nodo->compartido = 1;
+    nodo->simbolo = simbolo;
+    nodo->valor = (char*)valor;
+    nodo->izquierdo = izq;
+    nodo->derecho = der;
+    nodo->linea = linea;
+    nodo->columna = columna;
+    compartido->hash = hash;
+
+    tabla->casillas[casilla] = compartido;
+    tabla->num_nodos++;
+    return nodo;
+}
+
+// Elemento pendiente del recorrido en postorden de hash_estructural
+typedef struct {
+    const NodoArbol *nodo;
+    int hijos_listos;
+} PendienteHash;
+
+// Hash estructural de un subárbol. En los nodos compartidos está guardado;
+// en los demás se calcula en postorden con pilas en el heap, sin recursión
+uint32_t hash_estructural(const NodoArbol *nodo) {
+    if (!nodo) return 0;
+    if (nodo->compartido) return ((const NodoCompartido*)nodo)->hash;
+
+    int capacidad = 64;
+    int pendientes = 0;
+    int calculados = 0;
+    PendienteHash *pila = (PendienteHash*)malloc(capacidad * sizeof(PendienteHash));
+    uint32_t *hashes = (uint32_t*)malloc(capacidad * sizeof(uint32_t));
+    if (!pila || !hashes) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para calcular el hash\n");
+        free(pila);
+        free(hashes);
+        return 0;
+    }
+    pila[pendientes].nodo = nodo;
+    pila[pendientes].hijos_listos = 0;
+    pendientes++;
+
+    // Cada nodo se visita dos veces: al apilar sus hijos y, cuando sus
+    // hashes ya están en 'hashes', para combinarlos
+    while (pendientes > 0) {
+        PendienteHash *actual = &pila[pendientes - 1];
+        const NodoArbol *n = actual->nodo;
+
+        if (n->compartido) {
+            pendientes--;
+            hashes[calculados++] = ((const NodoCompartido*)n)->hash;
+        } else if (actual->hijos_listos) {
+            pendientes--;
+            uint32_t hash_der = n->derecho ? hashes[--calculados] : 0;
+            uint32_t hash_izq = n->izquierdo ? hashes[--calculados] : 0;
+            hashes[calculados++] = combinar_hash((TipoNodo)n->tipo, n->valor, hash_izq, hash_der);
+        } else {
+            actual->hijos_listos = 1;
+            if (pendientes + 2 > capacidad) {
+                capacidad *= 2;
+                PendienteHash *nueva_pila = (PendienteHash*)realloc(pila, capacidad * sizeof(PendienteHash));
+                uint32_t *nuevos_hashes = nueva_pila ? (uint32_t*)realloc(hashes, capacidad * sizeof(uint32_t)) : NULL;
+                if (nueva_pila) pila = nueva_pila;
+                if (nuevos_hashes) hashes = nuevos_hashes;
+                if (!nueva_pila || !nuevos_hashes) {
+                    fprintf(stderr, "Error: No se pudo asignar memoria para calcular el hash\n");
+                    free(pila);
+                    free(hashes);
+                    return 0;
+                }
+            }
+            // El izquierdo se apila último para combinarse primero
+            if (n->derecho) {
+                pila[pendientes].nodo = n->derecho;
+                pila[pendientes].hijos_listos = 0;
+                pendientes++;
+            }
+            if (n->izquierdo) {
+                pila[pendientes].nodo = n->izquierdo;
+                pila[pendientes].hijos_listos = 0;
+                pendientes++;
+            }
+        }
+    }
+
+    uint32_t hash = hashes[0];
+    free(pila);
+    free(hashes);
+    return hash;
+}
@@ -0,0 +1,294 @@
+#include "emisor.h"
+
+// ===== Texto indentado =====
+
+static void indentado_inicio(Salida *salida, int numero_linea, const char *entrada, size_t longitud) {
+    if (numero_linea > 0) {
+        salida_printf(salida, "Línea %d: ", numero_linea);
+    }
+    salida_printf(salida, "🔍 Analizando: %.*s\n", (int)longitud, entrada);
+    salida_printf(salida, "----------------------------------------\n");
+}
+
+static void indentado_arbol(Salida *salida, const NodoArbol *arbol) {
+    salida_printf(salida, "✅ ANÁLISIS SINTÁCTICO EXITOSO\n");
+    salida_printf(salida, "Árbol de análisis sintáctico:\n");
+    imprimir_arbol(salida, (NodoArbol*)arbol, 0);
+}
+
+static void indentado_error(Salida *salida, const char *mensaje) {
+    salida_printf(salida, "%s\n", mensaje);
+    salida_printf(salida, "❌ ERROR EN EL ANÁLISIS SINTÁCTICO\n");
+}
+
+static void indentado_fin(Salida *salida) {
+    salida_printf(salida, "----------------------------------------\n\n");
+}
+
+const EmisorArbol emisor_indentado = {
+    "indentado", indentado_inicio, indentado_arbol, indentado_error, indentado_fin
+};
+
+// ===== Recorrido genérico =====
+
+// Funciones que un formato anidado llama durante el recorrido: al entrar en
+// un nodo, antes de cada hijo y al salir del nodo
+typedef struct {
+    void (*abrir)(Salida *salida, const NodoArbol *nodo);
+    void (*antes_de_hijo)(Salida *salida, const NodoArbol *padre, int es_derecho);
+    void (*cerrar)(Salida *salida, const NodoArbol *nodo);
+} FormatoAnidado;
+
+// Elemento pendiente del recorrido de emitir_anidado
+typedef struct {
+    const NodoArbol *nodo;
+    int paso; // 0: sin abrir, 1: izquierdo emitido, 2: derecho emitido
+} PendienteEmisor;
+
+// Recorre el árbol en profundidad sin recursión, como imprimir_arbol
+static void emitir_anidado(Salida *salida, const NodoArbol *raiz, const FormatoAnidado *formato) {
+    int capacidad = 64;
+    int cantidad = 0;
+    PendienteEmisor *pila = (PendienteEmisor*)malloc(capacidad * sizeof(PendienteEmisor));
+    if (!pila) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para imprimir el árbol\n");
+        return;
+    }
+    pila[cantidad].nodo = raiz;
+    pila[cantidad].paso = 0;
+    cantidad++;
+
+    while (cantidad > 0) {
+        PendienteEmisor *actual = &pila[cantidad - 1];
+        const NodoArbol *nodo = actual->nodo;
+        const NodoArbol *hijo = NULL;
+
+        if (actual->paso == 0) {
+            formato->abrir(salida, nodo);
+            actual->paso = 1;
+            if (nodo->izquierdo) {
+                formato->antes_de_hijo(salida, nodo, 0);
+                hijo = nodo->izquierdo;
+            }
+        } else if (actual->paso == 1) {
+            actual->paso = 2;
+            if (nodo->derecho) {
+                formato->antes_de_hijo(salida, nodo, 1);
+                hijo = nodo->derecho;
+            }
+        } else {
+            formato->cerrar(salida, nodo);
+            cantidad--;
+        }
+
+        if (hijo) {
+            if (cantidad == capacidad) {
+                capacidad *= 2;
+                PendienteEmisor *nueva = (PendienteEmisor*)realloc(pila, capacidad * sizeof(PendienteEmisor));
+                if (!nueva) {
+                    fprintf(stderr, "Error: No se pudo asignar memoria para imprimir el árbol\n");
+                    break;
+                }
+                pila = nueva;
+            }
+            pila[cantidad].nodo = hijo;
+            pila[cantidad].paso = 0;
+            cantidad++;
+        }
+    }
+
+    free(pila);
+}
+
+// ===== JSON =====
+
+// Escribe 'texto' como cadena JSON, con comillas y caracteres escapados
+// Longitud de la secuencia UTF-8 válida que empieza en texto[0] (0 si no lo
+// es: byte suelto, secuencia cortada, forma larga o sustituto UTF-16)
+static size_t secuencia_utf8(const unsigned char *texto, size_t disponible) {
+    unsigned char c = texto[0];
+    size_t n;
+    unsigned char minimo = 0x80, maximo = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF) {
+        n = 2;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        n = 3;
+        if (c == 0xE0) minimo = 0xA0;
+        if (c == 0xED) maximo = 0x9F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        n = 4;
+        if (c == 0xF0) minimo = 0x90;
+        if (c == 0xF4) maximo = 0x8F;
+    } else {
+        return 0;
+    }
+    if (n > disponible || texto[1] < minimo || texto[1] > maximo) {
+        return 0;
+    }
+    for (size_t k = 2; k < n; k++) {
+        if ((texto[k] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return n;
+}
+
+// Los bytes que no forman UTF-8 válido (por ejemplo, un carácter multibyte
+// cortado por el lexer) se escapan como \u00XX para que la línea siga siendo JSON
+static void escribir_cadena_json(Salida *salida, const char *texto, size_t longitud) {
+    static const char hexadecimal[] = "0123456789abcdef";
+    const char *tramo = texto;
+
+    salida_escribir(salida, "\"", 1);
+    for (size_t i = 0; i < longitud; i++) {
+        unsigned char c = (unsigned char)texto[i];
+        if (c >= 0x80) {
+            size_t n = secuencia_utf8((const unsigned char*)texto + i, longitud - i);
+            if (n > 0) {
+                i += n - 1;
+                continue;
+            }
+        } else if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        salida_escribir(salida, tramo, (size_t)(texto + i - tramo));
+        tramo = texto + i + 1;
+        switch (c) {
+            case '"': salida_escribir(salida, "\\\"", 2); break;
+            case '\\': salida_escribir(salida, "\\\\", 2); break;
+            case '\n': salida_escribir(salida, "\\n", 2); break;
+            case '\t': salida_escribir(salida, "\\t", 2); break;
+            case '\r': salida_escribir(salida, "\\r", 2); break;
+            default: {
+                char escape[6] = { '\\', 'u', '0', '0', hexadecimal[c >> 4], hexadecimal[c & 0xF] };
+                salida_escribir(salida, escape, sizeof(escape));
+            }
+        }
+    }
+    salida_escribir(salida, tramo, (size_t)(texto + longitud - tramo));
+    salida_escribir(salida, "\"", 1);
+}
+
+static void json_abrir(Salida *salida, const NodoArbol *nodo) {
+    salida_escribir(salida, "{\"tipo\":", 8);
+    const char *tipo = tipo_nodo_a_string((TipoNodo)nodo->tipo);
+    escribir_cadena_json(salida, tipo, strlen(tipo));
+    if (nodo->tipo == NODO_IDENTIFICADOR && nodo->valor) {
+        salida_escribir(salida, ",\"valor\":", 9);
+        escribir_cadena_json(salida, nodo->valor, strlen(nodo->valor));
+    }
+}
+
+static void json_antes_de_hijo(Salida *salida, const NodoArbol *padre, int es_derecho) {
+    (void)padre;
+    if (es_derecho) {
+        salida_escribir(salida, ",\"derecho\":", 11);
+    } else {
+        salida_escribir(salida, ",\"izquierdo\":", 13);
+    }
+}
+
+static void json_cerrar(Salida *salida, const NodoArbol *nodo) {
+    (void)nodo;
+    salida_escribir(salida, "}", 1);
+}
+
+static const FormatoAnidado formato_json = { json_abrir, json_antes_de_hijo, json_cerrar };
+
+static void json_inicio(Salida *salida, int numero_linea, const char *entrada, size_t longitud) {
+    salida_escribir(salida, "{", 1);
+    if (numero_linea > 0) {
+        salida_printf(salida, "\"linea\":%d,", numero_linea);
+    }
+    salida_escribir(salida, "\"entrada\":", 10);
+    escribir_cadena_json(salida, entrada, longitud);
+}
+
+static void json_arbol(Salida *salida, const NodoArbol *arbol) {
+    salida_escribir_cadena(salida, ",\"valido\":true,\"arbol\":");
+    emitir_anidado(salida, arbol, &formato_json);
+}
+
+static void json_error(Salida *salida, const char *mensaje) {
+    salida_escribir_cadena(salida, ",\"valido\":false,\"error\":");
+    escribir_cadena_json(salida, mensaje, strlen(mensaje));
+}
+
+static void json_fin(Salida *salida) {
+    salida_escribir(salida, "}\n", 2);
+}
+
+const EmisorArbol emisor_json = {
+    "json", json_inicio, json_arbol, json_error, json_fin
+};
+
+// ===== S-expresiones =====
+
+// Los identificadores se escriben por su nombre; el resto de los nodos como
+// (operador hijos...). Los paréntesis de la entrada se conservan como (paren x)
+static const char* nombre_sexp(const NodoArbol *nodo) {
+    if (nodo->tipo == NODO_PARENTESIS) {
+        return "paren";
+    }
+    return tipo_nodo_a_string((TipoNodo)nodo->tipo);
+}
+
+static void sexp_abrir(Salida *salida, const NodoArbol *nodo) {
+    if (nodo->izquierdo || nodo->derecho) {
+        salida_escribir(salida, "(", 1);
+        salida_escribir_cadena(salida, nombre_sexp(nodo));
+    } else {
+        salida_escribir_cadena(salida, nodo->tipo == NODO_IDENTIFICADOR && nodo->valor ? nodo->valor : nombre_sexp(nodo));
+    }
+}
+
+static void sexp_antes_de_hijo(Salida *salida, const NodoArbol *padre, int es_derecho) {
+    (void)padre;
+    (void)es_derecho;
+    salida_escribir(salida, " ", 1);
+}
+
+static void sexp_cerrar(Salida *salida, const NodoArbol *nodo) {
+    if (nodo->izquierdo || nodo->derecho) {
+        salida_escribir(salida, ")", 1);
+    }
+}
+
+static const FormatoAnidado formato_sexp = { sexp_abrir, sexp_antes_de_hijo, sexp_cerrar };
+
+static void sexp_inicio(Salida *salida, int numero_linea, const char *entrada, size_t longitud) {
+    (void)entrada;
+    (void)longitud;
+    if (numero_linea > 0) {
+        salida_printf(salida, "%d ", numero_linea);
+    }
+}
+
+static void sexp_arbol(Salida *salida, const NodoArbol *arbol) {
+    emitir_anidado(salida, arbol, &formato_sexp);
+}
+
+// El mensaje va entre comillas, con '"' y '\' escapados como en JSON
+static void sexp_error(Salida *salida, const char *mensaje) {
+    salida_escribir(salida, "(error ", 7);
+    escribir_cadena_json(salida, mensaje, strlen(mensaje));
+    salida_escribir(salida, ")", 1);
+}
+
+static void sexp_fin(Salida *salida) {
+    salida_escribir(salida, "\n", 1);
+}
+
+const EmisorArbol emisor_sexp = {
+    "sexp", sexp_inicio, sexp_arbol, sexp_error, sexp_fin
+};
+
+const EmisorArbol* buscar_emisor(const char *nombre) {
+    static const EmisorArbol *emisores[] = { &emisor_indentado, &emisor_json, &emisor_sexp };
+    for (size_t i = 0; i < sizeof(emisores) / sizeof(emisores[0]); i++) {
+        if (strcmp(emisores[i]->nombre, nombre) == 0) {
+            return emisores[i];
+        }
+    }
+    return NULL;
+}
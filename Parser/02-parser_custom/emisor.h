@@ -0,0 +1,28 @@
+#ifndef EMISOR_H
+#define EMISOR_H
+
+#include "parser.h"
+
+// Emisores del resultado de cada análisis. Todos escriben en una Salida
+// (nunca directamente en stdout), así que la salida de varios hilos se
+// sigue volcando en orden. Para cada entrada se llama a 'inicio', después
+// a 'arbol' o a 'error' y por último a 'fin'
+typedef struct {
+    const char *nombre;
+    // numero_linea: línea del archivo (0 si la entrada no viene de un archivo)
+    void (*inicio)(Salida *salida, int numero_linea, const char *entrada, size_t longitud);
+    void (*arbol)(Salida *salida, const NodoArbol *arbol);
+    void (*error)(Salida *salida, const char *mensaje);
+    void (*fin)(Salida *salida);
+} EmisorArbol;
+
+// Texto indentado (el formato original), JSON (un objeto por línea) y
+// S-expresiones compactas (una por línea)
+extern const EmisorArbol emisor_indentado;
+extern const EmisorArbol emisor_json;
+extern const EmisorArbol emisor_sexp;
+
+// Devuelve el emisor llamado 'nombre' o NULL si no existe
+const EmisorArbol* buscar_emisor(const char *nombre);
+
+#endif // EMISOR_H
@@ -0,0 +1,239 @@
+#include "escaneo.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ESCANEO_X86 1
+#include <immintrin.h>
+#endif
+
+// Clasificación ASCII, independiente del locale
+static inline int es_espacio(unsigned char c) {
+    return c == ' ' || c == '\t' || c == '\n';
+}
+
+static inline int es_caracter_identificador(unsigned char c) {
+    return (unsigned char)((c | 0x20) - 'a') < 26 || (unsigned char)(c - '0') < 10 || c == '_';
+}
+
+// Agrega los saltos de línea de los primeros 'cantidad' bytes de un bloque
+// cuyo mapa de bits de '\n' es 'mascara_saltos', a partir de 'base'
+static inline void contar_saltos(RachaEspacios *racha, unsigned int mascara_saltos, int cantidad, size_t base) {
+    if (cantidad < 32) {
+        mascara_saltos &= (1u << cantidad) - 1;
+    }
+    if (mascara_saltos) {
+        racha->saltos += __builtin_popcount(mascara_saltos);
+        racha->despues_ultimo_salto = base + (size_t)(32 - __builtin_clz(mascara_saltos));
+    }
+}
+
+static RachaEspacios espacios_escalar(const char *datos, size_t longitud, size_t i, RachaEspacios racha) {
+    while (i < longitud && es_espacio((unsigned char)datos[i])) {
+        if (datos[i] == '\n') {
+            racha.saltos++;
+            racha.despues_ultimo_salto = i + 1;
+        }
+        i++;
+    }
+    racha.longitud = i;
+    return racha;
+}
+
+static size_t identificador_escalar(const char *datos, size_t longitud, size_t i) {
+    while (i < longitud && es_caracter_identificador((unsigned char)datos[i])) {
+        i++;
+    }
+    return i;
+}
+
+static RachaEspacios espacios_escalar_completo(const char *datos, size_t longitud) {
+    RachaEspacios racha = { 0, 0, 0 };
+    return espacios_escalar(datos, longitud, 0, racha);
+}
+
+static size_t identificador_escalar_completo(const char *datos, size_t longitud) {
+    return identificador_escalar(datos, longitud, 0);
+}
+
+#ifdef ESCANEO_X86
+
+// Los bloques se cargan solo si caben completos en la entrada; el resto se
+// termina con el núcleo escalar para no leer fuera del buffer del llamador
+
+__attribute__((target("sse2")))
+static RachaEspacios espacios_sse2(const char *datos, size_t longitud) {
+    RachaEspacios racha = { 0, 0, 0 };
+    const __m128i espacio = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i salto = _mm_set1_epi8('\n');
+    size_t i = 0;
+    
+    while (i + 16 <= longitud) {
+        __m128i bloque = _mm_loadu_si128((const __m128i*)(datos + i));
+        __m128i es_salto = _mm_cmpeq_epi8(bloque, salto);
+        __m128i es_blanco = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bloque, espacio),
+                                                      _mm_cmpeq_epi8(bloque, tab)), es_salto);
+        unsigned int blancos = (unsigned int)_mm_movemask_epi8(es_blanco);
+        unsigned int saltos = (unsigned int)_mm_movemask_epi8(es_salto);
+        
+        if (blancos != 0xFFFF) {
+            int fin = __builtin_ctz(~blancos);
+            contar_saltos(&racha, saltos, fin, i);
+            racha.longitud = i + (size_t)fin;
+            return racha;
+        }
+        contar_saltos(&racha, saltos, 16, i);
+        i += 16;
+    }
+    return espacios_escalar(datos, longitud, i, racha);
+}
+
+// Máscara de bytes de identificador: letra ASCII (sin distinguir mayúsculas), dígito o '_'
+__attribute__((target("sse2")))
+static inline unsigned int mascara_identificador_sse2(__m128i bloque) {
+    __m128i minuscula = _mm_or_si128(bloque, _mm_set1_epi8(0x20));
+    __m128i letra = _mm_and_si128(_mm_cmpgt_epi8(minuscula, _mm_set1_epi8('a' - 1)),
+                                  _mm_cmplt_epi8(minuscula, _mm_set1_epi8('z' + 1)));
+    __m128i digito = _mm_and_si128(_mm_cmpgt_epi8(bloque, _mm_set1_epi8('0' - 1)),
+                                   _mm_cmplt_epi8(bloque, _mm_set1_epi8('9' + 1)));
+    __m128i guion = _mm_cmpeq_epi8(bloque, _mm_set1_epi8('_'));
+    return (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(letra, digito), guion));
+}
+
+__attribute__((target("sse2")))
+static size_t identificador_sse2(const char *datos, size_t longitud) {
+    size_t i = 0;
+    while (i + 16 <= longitud) {
+        unsigned int validos = mascara_identificador_sse2(_mm_loadu_si128((const __m128i*)(datos + i)));
+        if (validos != 0xFFFF) {
+            return i + (size_t)__builtin_ctz(~validos);
+        }
+        i += 16;
+    }
+    return identificador_escalar(datos, longitud, i);
+}
+
+__attribute__((target("avx2")))
+static RachaEspacios espacios_avx2(const char *datos, size_t longitud) {
+    RachaEspacios racha = { 0, 0, 0 };
+    const __m256i espacio = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i salto = _mm256_set1_epi8('\n');
+    size_t i = 0;
+    
+    while (i + 32 <= longitud) {
+        __m256i bloque = _mm256_loadu_si256((const __m256i*)(datos + i));
+        __m256i es_salto = _mm256_cmpeq_epi8(bloque, salto);
+        __m256i es_blanco = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(bloque, espacio),
+                                                            _mm256_cmpeq_epi8(bloque, tab)), es_salto);
+        unsigned int blancos = (unsigned int)_mm256_movemask_epi8(es_blanco);
+        unsigned int saltos = (unsigned int)_mm256_movemask_epi8(es_salto);
+        
+        if (blancos != 0xFFFFFFFFu) {
+            int fin = __builtin_ctz(~blancos);
+            contar_saltos(&racha, saltos, fin, i);
+            racha.longitud = i + (size_t)fin;
+            return racha;
+        }
+        contar_saltos(&racha, saltos, 32, i);
+        i += 32;
+    }
+    return espacios_escalar(datos, longitud, i, racha);
+}
+
+__attribute__((target("avx2")))
+static size_t identificador_avx2(const char *datos, size_t longitud) {
+    size_t i = 0;
+    while (i + 32 <= longitud) {
+        __m256i bloque = _mm256_loadu_si256((const __m256i*)(datos + i));
+        __m256i minuscula = _mm256_or_si256(bloque, _mm256_set1_epi8(0x20));
+        __m256i letra = _mm256_and_si256(_mm256_cmpgt_epi8(minuscula, _mm256_set1_epi8('a' - 1)),
+                                         _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), minuscula));
+        __m256i digito = _mm256_and_si256(_mm256_cmpgt_epi8(bloque, _mm256_set1_epi8('0' - 1)),
+                                          _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), bloque));
+        __m256i guion = _mm256_cmpeq_epi8(bloque, _mm256_set1_epi8('_'));
+        unsigned int validos = (unsigned int)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_or_si256(letra, digito), guion));
+        if (validos != 0xFFFFFFFFu) {
+            return i + (size_t)__builtin_ctz(~validos);
+        }
+        i += 32;
+    }
+    return identificador_escalar(datos, longitud, i);
+}
+
+#endif // ESCANEO_X86
+
+// Núcleo activo
+static RachaEspacios (*funcion_espacios)(const char*, size_t) = 0;
+static size_t (*funcion_identificador)(const char*, size_t) = 0;
+static KernelEscaneo kernel_activo = KERNEL_AUTO;
+
+int escaneo_seleccionar(KernelEscaneo kernel);
+
+// Con GCC/Clang el núcleo se elige al cargar el programa, antes de que
+// existan hilos; en otros compiladores se elige en la primera llamada
+#ifdef __GNUC__
+__attribute__((constructor))
+static void escaneo_inicializar(void) {
+    escaneo_seleccionar(KERNEL_AUTO);
+}
+#endif
+
+int escaneo_seleccionar(KernelEscaneo kernel) {
+#ifdef ESCANEO_X86
+    __builtin_cpu_init();
+    int tiene_sse2 = __builtin_cpu_supports("sse2");
+    int tiene_avx2 = __builtin_cpu_supports("avx2");
+    if (kernel == KERNEL_AUTO) {
+        kernel = tiene_avx2 ? KERNEL_AVX2 : (tiene_sse2 ? KERNEL_SSE2 : KERNEL_ESCALAR);
+    }
+    if (kernel == KERNEL_AVX2) {
+        if (!tiene_avx2) return 0;
+        funcion_espacios = espacios_avx2;
+        funcion_identificador = identificador_avx2;
+        kernel_activo = kernel;
+        return 1;
+    }
+    if (kernel == KERNEL_SSE2) {
+        if (!tiene_sse2) return 0;
+        funcion_espacios = espacios_sse2;
+        funcion_identificador = identificador_sse2;
+        kernel_activo = kernel;
+        return 1;
+    }
+#else
+    if (kernel == KERNEL_AUTO) {
+        kernel = KERNEL_ESCALAR;
+    }
+    if (kernel != KERNEL_ESCALAR) {
+        return 0;
+    }
+#endif
+    funcion_espacios = espacios_escalar_completo;
+    funcion_identificador = identificador_escalar_completo;
+    kernel_activo = KERNEL_ESCALAR;
+    return 1;
+}
+
+const char* escaneo_nombre_kernel(void) {
+    switch (kernel_activo) {
+        case KERNEL_ESCALAR: return "escalar";
+        case KERNEL_SSE2: return "sse2";
+        case KERNEL_AVX2: return "avx2";
+        default: return "auto";
+    }
+}
+
+RachaEspacios escanear_espacios(const char *datos, size_t longitud) {
+    if (!funcion_espacios) {
+        escaneo_seleccionar(KERNEL_AUTO);
+    }
+    return funcion_espacios(datos, longitud);
+}
+
+size_t escanear_identificador(const char *datos, size_t longitud) {
+    if (!funcion_identificador) {
+        escaneo_seleccionar(KERNEL_AUTO);
+    }
+    return funcion_identificador(datos, longitud);
+}
@@ -0,0 +1,34 @@
+#ifndef ESCANEO_H
+#define ESCANEO_H
+
+#include <stddef.h>
+
+// Núcleos de escaneo del lexer: encuentran el final de una secuencia de
+// espacios o de caracteres de identificador. Existe una versión escalar y,
+// en x86, versiones SSE2 (16 bytes por paso) y AVX2 (32 bytes por paso)
+// que se eligen en tiempo de ejecución según la CPU.
+
+typedef enum {
+    KERNEL_AUTO,
+    KERNEL_ESCALAR,
+    KERNEL_SSE2,
+    KERNEL_AVX2
+} KernelEscaneo;
+
+// Resultado del escaneo de espacios: bytes saltados, saltos de línea
+// encontrados y posición siguiente al último salto (si saltos > 0)
+typedef struct {
+    size_t longitud;
+    int saltos;
+    size_t despues_ultimo_salto;
+} RachaEspacios;
+
+// Funciones de escaneo
+RachaEspacios escanear_espacios(const char *datos, size_t longitud);
+size_t escanear_identificador(const char *datos, size_t longitud);
+
+// Selección del núcleo (devuelve 0 si la CPU no lo admite)
+int escaneo_seleccionar(KernelEscaneo kernel);
+const char* escaneo_nombre_kernel(void);
+
+#endif // ESCANEO_H
@@ -0,0 +1,636 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "incremental.h"
+
+#define TAMANO_BLOQUE_DOCUMENTO (16 * 1024)
+
+// Margen de nodos reemplazados que se tolera antes de compactar
+#define MARGEN_NODOS_MUERTOS 4096
+
+// Nodo del documento: el NodoArbol va primero para que el árbol se recorra
+// como cualquier otro. Las posiciones son desplazamientos en bytes:
+// 'desplazamiento' es el inicio del nodo respecto al inicio de su padre (en
+// la raíz, respecto al texto), 'longitud' va del primer byte de su primer
+// token al último de su último token y 'ancla' es el token del que el nodo
+// toma linea y columna (el operador, el '(' o el identificador). 'nodos' es
+// el tamaño del subárbol
+typedef struct {
+    NodoArbol nodo;
+    int desplazamiento;
+    int longitud;
+    int ancla;
+    int nodos;
+} NodoIncremental;
+
+// Nodo del camino desde la raíz hasta el subárbol que contiene la edición
+// 'inicio' es su posición absoluta antes de editar; 'lado' indica si es el
+// hijo izquierdo (0) o derecho (1) del paso anterior (-1 en la raíz)
+struct PasoIncremental {
+    NodoIncremental *nodo;
+    int inicio;
+    int lado;
+};
+
+// Categoría gramatical de un subárbol: un factor (F), un producto (T) o una suma (E)
+enum { CATEGORIA_F, CATEGORIA_T, CATEGORIA_E };
+
+static int categoria(const NodoArbol *nodo) {
+    switch (nodo->tipo) {
+        case NODO_SUMA: return CATEGORIA_E;
+        case NODO_MULTIPLICACION: return CATEGORIA_T;
+        default: return CATEGORIA_F;
+    }
+}
+
+// Mayor categoría que admite el hijo 'lado' de 'padre' sin cambiar la forma
+// del resto del árbol: E' -> + T E' deja un T a la derecha de la suma y
+// T' -> * F T' un F a la derecha del producto (ambos asocian por la izquierda)
+static int categoria_admitida(const NodoArbol *padre, int lado) {
+    switch (padre->tipo) {
+        case NODO_SUMA: return lado == 0 ? CATEGORIA_E : CATEGORIA_T;
+        case NODO_MULTIPLICACION: return lado == 0 ? CATEGORIA_T : CATEGORIA_F;
+        default: return CATEGORIA_E;
+    }
+}
+
+static inline int es_espacio(char c) {
+    return c == ' ' || c == '\t' || c == '\n';
+}
+
+// Caracteres que pueden continuar un identificador: [a-zA-Z0-9_]
+static inline int continua_identificador(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static inline int tamano_subarbol(const NodoArbol *nodo) {
+    return nodo ? ((const NodoIncremental*)nodo)->nodos : 0;
+}
+
+static int reservar(void **arreglo, int *capacidad, int minimo, size_t tamano) {
+    if (minimo <= *capacidad) {
+        return 1;
+    }
+    int nueva_capacidad = *capacidad ? *capacidad : 16;
+    while (nueva_capacidad < minimo) {
+        nueva_capacidad *= 2;
+    }
+    void *nuevo = realloc(*arreglo, (size_t)nueva_capacidad * tamano);
+    if (!nuevo) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el documento\n");
+        return 0;
+    }
+    *arreglo = nuevo;
+    *capacidad = nueva_capacidad;
+    return 1;
+}
+
+static NodoIncremental* nuevo_nodo_incremental(DocumentoIncremental *documento, const NodoArbol *original) {
+    NodoIncremental *nodo = (NodoIncremental*)arena_asignar(&documento->arena, sizeof(NodoIncremental));
+    if (!nodo) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el nodo\n");
+        return NULL;
+    }
+    nodo->nodo.tipo = original->tipo;
+    nodo->nodo.en_arena = 1;
+    nodo->nodo.compartido = 0;
+    nodo->nodo.simbolo = original->simbolo;
+    // Los identificadores ya están internados en la tabla del documento; los
+    // operadores usan su representación constante
+    nodo->nodo.valor = original->tipo == NODO_IDENTIFICADOR ? original->valor
+                                                            : tipo_nodo_a_string((TipoNodo)original->tipo);
+    nodo->nodo.izquierdo = NULL;
+    nodo->nodo.derecho = NULL;
+    nodo->nodo.linea = original->linea;
+    nodo->nodo.columna = original->columna;
+    documento->nodos_creados++;
+    return nodo;
+}
+
+
+// ===== Conversión de un árbol del parser =====
+
+typedef struct {
+    const NodoArbol *nodo;
+    int paso; // 0: sin visitar, 1: izquierdo pendiente, 2: hijos convertidos
+} PendienteConversion;
+
+typedef struct {
+    NodoIncremental *nodo;
+    int inicio;
+    int fin;
+} NodoConvertido;
+
+// Copia en la arena del documento el árbol 'raiz', analizado sobre 'texto',
+// y calcula los desplazamientos de cada nodo a partir de su linea y columna
+// dentro de ese texto. Devuelve la copia con el inicio y el fin de su texto
+static NodoIncremental* convertir_arbol(DocumentoIncremental *documento, const NodoArbol *raiz,
+                                        const char *texto, int longitud, int *inicio, int *fin) {
+    // Inicio de cada línea del texto
+    int num_lineas = 1;
+    if (!reservar((void**)&documento->inicios_linea, &documento->capacidad_lineas, 1, sizeof(int))) {
+        return NULL;
+    }
+    documento->inicios_linea[0] = 0;
+    for (const char *salto = memchr(texto, '\n', longitud); salto;
+         salto = memchr(salto + 1, '\n', longitud - (salto + 1 - texto))) {
+        if (!reservar((void**)&documento->inicios_linea, &documento->capacidad_lineas,
+                      num_lineas + 1, sizeof(int))) {
+            return NULL;
+        }
+        documento->inicios_linea[num_lineas++] = (int)(salto + 1 - texto);
+    }
+
+    int capacidad_pila = 64, capacidad_hechos = 64;
+    int num_pila = 0, num_hechos = 0;
+    PendienteConversion *pila = (PendienteConversion*)malloc(capacidad_pila * sizeof(PendienteConversion));
+    NodoConvertido *hechos = (NodoConvertido*)malloc(capacidad_hechos * sizeof(NodoConvertido));
+    NodoIncremental *resultado = NULL;
+    if (!pila || !hechos) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el documento\n");
+        goto fin_conversion;
+    }
+
+    pila[num_pila].nodo = raiz;
+    pila[num_pila].paso = 0;
+    num_pila++;
+
+    while (num_pila > 0) {
+        PendienteConversion *actual = &pila[num_pila - 1];
+        const NodoArbol *original = actual->nodo;
+        const NodoArbol *hijo = NULL;
+
+        if (actual->paso == 0) {
+            actual->paso = 1;
+            hijo = original->izquierdo;
+        } else if (actual->paso == 1) {
+            actual->paso = 2;
+            hijo = original->derecho;
+        } else {
+            num_pila--;
+            NodoIncremental *nodo = nuevo_nodo_incremental(documento, original);
+            if (!nodo || !reservar((void**)&hechos, &capacidad_hechos, num_hechos + 1, sizeof(NodoConvertido))) {
+                goto fin_conversion;
+            }
+
+            int ancla = documento->inicios_linea[original->linea - 1] + original->columna - 1;
+            int inicio_nodo = ancla, fin_nodo;
+            if (original->tipo == NODO_IDENTIFICADOR) {
+                fin_nodo = ancla + (int)strlen(original->valor);
+                nodo->nodos = 1;
+            } else if (original->tipo == NODO_PARENTESIS) {
+                NodoConvertido contenido = hechos[--num_hechos];
+                nodo->nodo.izquierdo = &contenido.nodo->nodo;
+                contenido.nodo->desplazamiento = contenido.inicio - inicio_nodo;
+                nodo->nodos = 1 + contenido.nodo->nodos;
+                // El ')' es el primer token después del contenido
+                fin_nodo = contenido.fin;
+                while (es_espacio(texto[fin_nodo])) {
+                    fin_nodo++;
+                }
+                fin_nodo++;
+            } else {
+                NodoConvertido derecho = hechos[--num_hechos];
+                NodoConvertido izquierdo = hechos[--num_hechos];
+                nodo->nodo.izquierdo = &izquierdo.nodo->nodo;
+                nodo->nodo.derecho = &derecho.nodo->nodo;
+                nodo->nodos = 1 + izquierdo.nodo->nodos + derecho.nodo->nodos;
+                inicio_nodo = izquierdo.inicio;
+                fin_nodo = derecho.fin;
+                izquierdo.nodo->desplazamiento = 0;
+                derecho.nodo->desplazamiento = derecho.inicio - inicio_nodo;
+            }
+            nodo->longitud = fin_nodo - inicio_nodo;
+            nodo->ancla = ancla - inicio_nodo;
+
+            hechos[num_hechos].nodo = nodo;
+            hechos[num_hechos].inicio = inicio_nodo;
+            hechos[num_hechos].fin = fin_nodo;
+            num_hechos++;
+        }
+
+        if (hijo) {
+            if (!reservar((void**)&pila, &capacidad_pila, num_pila + 1, sizeof(PendienteConversion))) {
+                goto fin_conversion;
+            }
+            pila[num_pila].nodo = hijo;
+            pila[num_pila].paso = 0;
+            num_pila++;
+        }
+    }
+
+    resultado = hechos[0].nodo;
+    *inicio = hechos[0].inicio;
+    *fin = hechos[0].fin;
+
+fin_conversion:
+    free(pila);
+    free(hechos);
+    return resultado;
+}
+
+// Analiza 'texto' como una expresión completa. 'base' es la posición en el
+// documento de texto[0]: el árbol se devuelve con el inicio y el fin
+// absolutos de su primer y último token. Devuelve NULL si el texto no es
+// válido; el mensaje de error queda en 'mensaje' si no es NULL
+static NodoIncremental* analizar_texto(DocumentoIncremental *documento, const char *texto, int longitud,
+                                       int base, int *inicio, int *fin, char *mensaje) {
+    documento->bytes_reanalizados += longitud;
+
+    Parser *parser = crear_parser_con_simbolos(texto, longitud, &documento->simbolos);
+    if (!parser) {
+        if (mensaje) {
+            snprintf(mensaje, sizeof(documento->mensaje_error), "Error: No se pudo crear el parser");
+        }
+        return NULL;
+    }
+
+    NodoIncremental *arbol = NULL;
+    NodoArbol *original = analizar(parser);
+    if (!original) {
+        if (mensaje) {
+            memcpy(mensaje, parser->mensaje_error, sizeof(parser->mensaje_error));
+        }
+    } else {
+        arbol = convertir_arbol(documento, original, texto, longitud, inicio, fin);
+        if (arbol) {
+            *inicio += base;
+            *fin += base;
+        } else if (mensaje) {
+            snprintf(mensaje, sizeof(documento->mensaje_error), "Error: No se pudo asignar memoria para el árbol");
+        }
+    }
+
+    liberar_parser(parser);
+    return arbol;
+}
+
+// Vuelve a analizar el documento entero con una arena y una tabla de
+// símbolos nuevas, lo que también descarta los nodos reemplazados
+static int reanalizar_todo(DocumentoIncremental *documento) {
+    arena_liberar(&documento->arena);
+    arena_iniciar(&documento->arena, TAMANO_BLOQUE_DOCUMENTO);
+    simbolos_liberar(&documento->simbolos);
+    simbolos_iniciar(&documento->simbolos);
+    documento->nodos_creados = 0;
+    documento->nodos_vivos = 0;
+    documento->reanalisis_completos++;
+
+    int inicio, fin;
+    documento->mensaje_error[0] = '\0';
+    NodoIncremental *raiz = analizar_texto(documento, documento->texto, documento->longitud, 0,
+                                           &inicio, &fin, documento->mensaje_error);
+    documento->arbol = raiz ? &raiz->nodo : NULL;
+    documento->posiciones_al_dia = 1;
+    if (raiz) {
+        raiz->desplazamiento = inicio;
+        documento->nodos_vivos = raiz->nodos;
+    }
+    return 1;
+}
+
+int incremental_iniciar(DocumentoIncremental *documento, const char *texto, int longitud) {
+    memset(documento, 0, sizeof(*documento));
+    arena_iniciar(&documento->arena, TAMANO_BLOQUE_DOCUMENTO);
+    simbolos_iniciar(&documento->simbolos);
+
+    if (!reservar((void**)&documento->texto, &documento->capacidad, longitud + 1, 1)) {
+        return 0;
+    }
+    memcpy(documento->texto, texto, longitud);
+    documento->texto[longitud] = '\0';
+    documento->longitud = longitud;
+    return reanalizar_todo(documento);
+}
+
+void incremental_liberar(DocumentoIncremental *documento) {
+    arena_liberar(&documento->arena);
+    simbolos_liberar(&documento->simbolos);
+    free(documento->texto);
+    free(documento->camino);
+    free(documento->inicios_linea);
+    free(documento->temporal);
+    memset(documento, 0, sizeof(*documento));
+}
+
+// ===== Edición =====
+
+// Mueve el inicio de un nodo binario 'corrimiento' bytes hacia atrás, sin
+// mover su ancla ni su hijo derecho en el texto, y le suma 'nodos' nodos
+static void correr_inicio(NodoIncremental *nodo, int corrimiento, int nodos) {
+    ((NodoIncremental*)nodo->nodo.derecho)->desplazamiento += corrimiento;
+    nodo->ancla += corrimiento;
+    nodo->longitud += corrimiento;
+    nodo->nodos += nodos;
+}
+
+// Reanaliza el nodo binario del paso 'paso' cuando la edición no toca su
+// hijo izquierdo: en lugar de todo su texto se analiza un identificador de
+// relleno seguido del texto desde el final del hijo izquierdo, y el relleno
+// se sustituye después por ese hijo, que se reutiliza entero. Así, editar
+// el final de una cadena larga a + b + ... no vuelve a analizar la cadena.
+// Devuelve NULL si no se puede aplicar (el subárbol cambia de forma a la
+// izquierda del relleno o el texto nuevo no es válido)
+static NodoIncremental* reanalizar_derecha(DocumentoIncremental *documento, PasoIncremental *paso,
+                                           int desplazamiento, int delta, int *inicio, int *fin) {
+    NodoIncremental *nodo = paso->nodo;
+    if (nodo->nodo.tipo != NODO_SUMA && nodo->nodo.tipo != NODO_MULTIPLICACION) {
+        return NULL;
+    }
+    NodoIncremental *izquierdo = (NodoIncremental*)nodo->nodo.izquierdo;
+    int fin_izquierdo = paso->inicio + izquierdo->longitud;
+    int fin_nodo = paso->inicio + nodo->longitud + delta;
+    // El relleno no debe separar tokens que en el texto real van unidos
+    if (desplazamiento < fin_izquierdo ||
+        (fin_izquierdo < documento->longitud && continua_identificador(documento->texto[fin_izquierdo]))) {
+        return NULL;
+    }
+
+    int longitud = 1 + fin_nodo - fin_izquierdo;
+    if (!reservar((void**)&documento->temporal, &documento->capacidad_temporal, longitud, 1)) {
+        return NULL;
+    }
+    documento->temporal[0] = 'x';
+    memcpy(documento->temporal + 1, documento->texto + fin_izquierdo, longitud - 1);
+
+    NodoIncremental *nuevo = analizar_texto(documento, documento->temporal, longitud, fin_izquierdo - 1,
+                                            inicio, fin, NULL);
+    if (!nuevo) {
+        return NULL;
+    }
+    *inicio = paso->inicio;
+    if (nuevo->nodo.tipo == NODO_IDENTIFICADOR) {
+        // Solo queda el relleno: el hijo izquierdo ocupa el lugar del nodo
+        return izquierdo;
+    }
+
+    // El relleno es la primera hoja de la cadena izquierda del resultado
+    NodoIncremental *fondo = nuevo;
+    while (fondo->nodo.izquierdo->tipo == NODO_SUMA || fondo->nodo.izquierdo->tipo == NODO_MULTIPLICACION) {
+        fondo = (NodoIncremental*)fondo->nodo.izquierdo;
+    }
+    if (fondo->nodo.tipo == NODO_MULTIPLICACION && izquierdo->nodo.tipo == NODO_SUMA) {
+        return NULL;
+    }
+
+    // Los nodos de la cadena izquierda empiezan en el relleno; ahora
+    // empiezan donde empieza el hijo izquierdo
+    int corrimiento = fin_izquierdo - 1 - paso->inicio;
+    for (NodoIncremental *cadena = nuevo; ; cadena = (NodoIncremental*)cadena->nodo.izquierdo) {
+        correr_inicio(cadena, corrimiento, izquierdo->nodos - 1);
+        if (cadena == fondo) {
+            break;
+        }
+    }
+    fondo->nodo.izquierdo = &izquierdo->nodo;
+    izquierdo->desplazamiento = 0;
+    return nuevo;
+}
+
+// 'padre' es una suma (o un producto) cuyo hijo derecho se reanalizó como
+// otra suma (producto) u1 + ... + um: por la asociatividad a la izquierda,
+// padre.izquierdo + u1 + ... + um es el subárbol nuevo, con padre.izquierdo
+// + u1 en el fondo de su cadena izquierda. 'padre' se reutiliza para ese
+// nodo y solo se corrigen los m - 1 nodos de la cadena nueva
+static void reasociar(NodoIncremental *padre, int inicio_padre, NodoIncremental *nuevo, int inicio_nuevo) {
+    int corrimiento = inicio_nuevo - inicio_padre;
+    NodoIncremental *izquierdo = (NodoIncremental*)padre->nodo.izquierdo;
+    NodoIncremental *fondo = nuevo;
+    while (1) {
+        correr_inicio(fondo, corrimiento, 1 + izquierdo->nodos);
+        if (fondo->nodo.izquierdo->tipo != padre->nodo.tipo) {
+            break;
+        }
+        fondo = (NodoIncremental*)fondo->nodo.izquierdo;
+    }
+
+    NodoIncremental *primero = (NodoIncremental*)fondo->nodo.izquierdo;
+    padre->nodo.derecho = &primero->nodo;
+    padre->desplazamiento = 0;
+    padre->longitud = corrimiento + primero->longitud;
+    padre->nodos = 1 + izquierdo->nodos + primero->nodos;
+    primero->desplazamiento = corrimiento;
+    fondo->nodo.izquierdo = &padre->nodo;
+}
+
+// Cuelga 'hijo' (que empieza en 'inicio_hijo' y termina en 'fin_hijo') en el
+// lado 'lado' del paso 'indice' del camino y corrige las posiciones y los
+// tamaños de los nodos del camino hasta la raíz. 'delta' es el cambio de
+// longitud del texto: lo que está a la derecha de la edición se desplaza
+static void enlazar_en_camino(DocumentoIncremental *documento, int indice, int lado, NodoIncremental *hijo,
+                              int inicio_hijo, int fin_hijo, int delta) {
+    for (; indice >= 0; indice--) {
+        PasoIncremental *paso = &documento->camino[indice];
+        NodoIncremental *nodo = paso->nodo;
+        int ancla = paso->inicio + nodo->ancla;
+        int inicio, fin;
+
+        if (nodo->nodo.tipo == NODO_PARENTESIS) {
+            nodo->nodo.izquierdo = &hijo->nodo;
+            inicio = paso->inicio;
+            fin = paso->inicio + nodo->longitud + delta;
+        } else if (lado == 0) {
+            NodoIncremental *derecho = (NodoIncremental*)nodo->nodo.derecho;
+            int inicio_derecho = paso->inicio + derecho->desplazamiento + delta;
+            nodo->nodo.izquierdo = &hijo->nodo;
+            ancla += delta;
+            inicio = inicio_hijo;
+            fin = paso->inicio + nodo->longitud + delta;
+            derecho->desplazamiento = inicio_derecho - inicio;
+        } else {
+            nodo->nodo.derecho = &hijo->nodo;
+            inicio = paso->inicio;
+            fin = fin_hijo;
+        }
+        hijo->desplazamiento = inicio_hijo - inicio;
+        nodo->ancla = ancla - inicio;
+        nodo->longitud = fin - inicio;
+        nodo->nodos = 1 + tamano_subarbol(nodo->nodo.izquierdo) + tamano_subarbol(nodo->nodo.derecho);
+
+        hijo = nodo;
+        inicio_hijo = inicio;
+        fin_hijo = fin;
+        lado = paso->lado;
+    }
+
+    hijo->desplazamiento = inicio_hijo;
+    documento->arbol = &hijo->nodo;
+}
+
+int incremental_editar(DocumentoIncremental *documento, int desplazamiento, int borrados,
+                       const char *insertado, int longitud_insertado) {
+    if (desplazamiento < 0 || borrados < 0 || longitud_insertado < 0 ||
+        desplazamiento + borrados > documento->longitud) {
+        return 0;
+    }
+    int delta = longitud_insertado - borrados;
+    documento->ediciones++;
+    documento->posiciones_al_dia = 0;
+
+    // Camino hasta el nodo más profundo cuyo texto contiene la edición,
+    // incluidos sus bordes: en un árbol válido el carácter anterior y el
+    // siguiente a un nodo nunca forman un token con los suyos
+    int profundidad = 0;
+    NodoIncremental *nodo = (NodoIncremental*)documento->arbol;
+    int inicio = nodo ? nodo->desplazamiento : 0;
+    int lado = -1;
+    while (nodo && inicio <= desplazamiento && desplazamiento + borrados <= inicio + nodo->longitud) {
+        if (!reservar((void**)&documento->camino, &documento->capacidad_camino,
+                      profundidad + 1, sizeof(PasoIncremental))) {
+            return 0;
+        }
+        documento->camino[profundidad].nodo = nodo;
+        documento->camino[profundidad].inicio = inicio;
+        documento->camino[profundidad].lado = lado;
+        profundidad++;
+
+        NodoIncremental *padre = nodo;
+        int inicio_padre = inicio;
+        nodo = NULL;
+        for (lado = 0; lado < 2 && !nodo; lado++) {
+            NodoIncremental *hijo = (NodoIncremental*)(lado ? padre->nodo.derecho : padre->nodo.izquierdo);
+            if (hijo) {
+                inicio = inicio_padre + hijo->desplazamiento;
+                if (inicio <= desplazamiento && desplazamiento + borrados <= inicio + hijo->longitud) {
+                    nodo = hijo;
+                }
+            }
+        }
+        lado--;
+    }
+
+    // Aplicar la edición al texto
+    if (!reservar((void**)&documento->texto, &documento->capacidad, documento->longitud + delta + 1, 1)) {
+        return 0;
+    }
+    memmove(documento->texto + desplazamiento + longitud_insertado,
+            documento->texto + desplazamiento + borrados,
+            documento->longitud - desplazamiento - borrados + 1);
+    memcpy(documento->texto + desplazamiento, insertado, longitud_insertado);
+    documento->longitud += delta;
+
+    // Reanalizar desde el nodo más profundo; si su texto nuevo no es válido
+    // o no encaja en el lugar del nodo, se sube un nivel. El texto completo
+    // de la raíz (o una edición fuera de ella) se analiza como documento
+    for (int i = profundidad - 1; i >= 0; i--) {
+        PasoIncremental *paso = &documento->camino[i];
+        int inicio_nuevo, fin_nuevo;
+        NodoIncremental *nuevo = reanalizar_derecha(documento, paso, desplazamiento, delta,
+                                                    &inicio_nuevo, &fin_nuevo);
+        if (!nuevo && i > 0) {
+            nuevo = analizar_texto(documento, documento->texto + paso->inicio,
+                                   paso->nodo->longitud + delta, paso->inicio,
+                                   &inicio_nuevo, &fin_nuevo, NULL);
+        }
+        if (!nuevo) {
+            continue;
+        }
+
+        if (i == 0) {
+            nuevo->desplazamiento = inicio_nuevo;
+            documento->arbol = &nuevo->nodo;
+        } else {
+            PasoIncremental *paso_padre = &documento->camino[i - 1];
+            NodoIncremental *padre = paso_padre->nodo;
+            if (categoria(&nuevo->nodo) <= categoria_admitida(&padre->nodo, paso->lado)) {
+                enlazar_en_camino(documento, i - 1, paso->lado, nuevo, inicio_nuevo, fin_nuevo, delta);
+            } else if (paso->lado == 1 && nuevo->nodo.tipo == padre->nodo.tipo) {
+                reasociar(padre, paso_padre->inicio, nuevo, inicio_nuevo);
+                enlazar_en_camino(documento, i - 2, paso_padre->lado, nuevo,
+                                  paso_padre->inicio, fin_nuevo, delta);
+            } else {
+                // El subárbol nuevo queda como basura en la arena
+                continue;
+            }
+        }
+
+        documento->nodos_vivos = ((NodoIncremental*)documento->arbol)->nodos;
+        if (documento->nodos_creados > 2 * documento->nodos_vivos + MARGEN_NODOS_MUERTOS) {
+            return reanalizar_todo(documento);
+        }
+        return 1;
+    }
+
+    return reanalizar_todo(documento);
+}
+
+// ===== Posiciones =====
+
+typedef struct {
+    NodoIncremental *nodo;
+    int inicio;
+} PendientePosicion;
+
+// Línea (desde 1) del byte 'posicion', por búsqueda binaria en inicios_linea
+static int linea_de(const int *inicios_linea, int num_lineas, int posicion) {
+    int bajo = 0, alto = num_lineas - 1;
+    while (bajo < alto) {
+        int medio = (bajo + alto + 1) / 2;
+        if (inicios_linea[medio] <= posicion) {
+            bajo = medio;
+        } else {
+            alto = medio - 1;
+        }
+    }
+    return bajo + 1;
+}
+
+void incremental_actualizar_posiciones(DocumentoIncremental *documento) {
+    if (documento->posiciones_al_dia || !documento->arbol) {
+        documento->posiciones_al_dia = 1;
+        return;
+    }
+
+    int num_lineas = 1;
+    if (!reservar((void**)&documento->inicios_linea, &documento->capacidad_lineas, 1, sizeof(int))) {
+        return;
+    }
+    documento->inicios_linea[0] = 0;
+    for (const char *salto = memchr(documento->texto, '\n', documento->longitud); salto;
+         salto = memchr(salto + 1, '\n', documento->longitud - (salto + 1 - documento->texto))) {
+        if (!reservar((void**)&documento->inicios_linea, &documento->capacidad_lineas,
+                      num_lineas + 1, sizeof(int))) {
+            return;
+        }
+        documento->inicios_linea[num_lineas++] = (int)(salto + 1 - documento->texto);
+    }
+
+    int capacidad = 64, cantidad = 0;
+    PendientePosicion *pila = (PendientePosicion*)malloc(capacidad * sizeof(PendientePosicion));
+    if (!pila) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el documento\n");
+        return;
+    }
+    NodoIncremental *raiz = (NodoIncremental*)documento->arbol;
+    pila[cantidad].nodo = raiz;
+    pila[cantidad].inicio = raiz->desplazamiento;
+    cantidad++;
+
+    while (cantidad > 0) {
+        PendientePosicion actual = pila[--cantidad];
+        NodoIncremental *nodo = actual.nodo;
+        int ancla = actual.inicio + nodo->ancla;
+        int linea = linea_de(documento->inicios_linea, num_lineas, ancla);
+        nodo->nodo.linea = linea;
+        nodo->nodo.columna = ancla - documento->inicios_linea[linea - 1] + 1;
+
+        if (!reservar((void**)&pila, &capacidad, cantidad + 2, sizeof(PendientePosicion))) {
+            break;
+        }
+        if (nodo->nodo.derecho) {
+            NodoIncremental *derecho = (NodoIncremental*)nodo->nodo.derecho;
+            pila[cantidad].nodo = derecho;
+            pila[cantidad].inicio = actual.inicio + derecho->desplazamiento;
+            cantidad++;
+        }
+        if (nodo->nodo.izquierdo) {
+            NodoIncremental *izquierdo = (NodoIncremental*)nodo->nodo.izquierdo;
+            pila[cantidad].nodo = izquierdo;
+            pila[cantidad].inicio = actual.inicio + izquierdo->desplazamiento;
+            cantidad++;
+        }
+    }
+
+    free(pila);
+    documento->posiciones_al_dia = 1;
+}
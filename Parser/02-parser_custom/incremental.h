@@ -0,0 +1,60 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "parser.h"
+
+// Análisis incremental para el uso como editor: el documento conserva el
+// texto y su árbol, y cada edición (desplazamiento, bytes borrados, texto
+// insertado) vuelve a analizar solo el subárbol más pequeño que la contiene.
+// El resto de los nodos se reutiliza tal cual, así que el costo depende del
+// tamaño de la edición y de la profundidad del árbol, no de la longitud de
+// la expresión (salvo el memmove del texto, que es lineal pero muy barato).
+//
+// Cada nodo guarda su posición relativa a la de su padre, de modo que una
+// edición solo corrige los nodos del camino hasta la raíz. Por eso linea y
+// columna de los nodos no se mantienen en cada edición: hay que llamar a
+// incremental_actualizar_posiciones antes de leerlas
+typedef struct PasoIncremental PasoIncremental;
+
+typedef struct {
+    char *texto;              // Terminado en '\0'
+    int longitud;
+    int capacidad;
+    NodoArbol *arbol;         // NULL si el texto actual no es válido
+    char mensaje_error[256];  // Error del texto actual (si arbol es NULL)
+    // Nodos e identificadores de todos los árboles del documento. Los
+    // nodos reemplazados no se liberan uno a uno: cuando los creados
+    // superan al doble de los vivos, el documento se reanaliza desde cero
+    Arena arena;
+    TablaSimbolos simbolos;
+    long nodos_vivos;
+    long nodos_creados;
+    int posiciones_al_dia;
+    // Memoria auxiliar reutilizada entre ediciones
+    PasoIncremental *camino;
+    int capacidad_camino;
+    int *inicios_linea;
+    int capacidad_lineas;
+    char *temporal;
+    int capacidad_temporal;
+    // Estadísticas
+    long ediciones;
+    long reanalisis_completos;
+    long long bytes_reanalizados;
+} DocumentoIncremental;
+
+// Analiza 'texto' completo. Devuelve 0 solo si falta memoria; un texto no
+// válido deja arbol en NULL y el error en mensaje_error
+int incremental_iniciar(DocumentoIncremental *documento, const char *texto, int longitud);
+
+// Reemplaza 'borrados' bytes desde 'desplazamiento' por 'insertado' y
+// actualiza el árbol. Devuelve 0 si la edición se sale del texto o falta memoria
+int incremental_editar(DocumentoIncremental *documento, int desplazamiento, int borrados,
+                       const char *insertado, int longitud_insertado);
+
+// Recalcula linea y columna de todos los nodos (recorrido lineal)
+void incremental_actualizar_posiciones(DocumentoIncremental *documento);
+
+void incremental_liberar(DocumentoIncremental *documento);
+
+#endif // INCREMENTAL_H
@@ -0,0 +1,569 @@
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "jit.h"
+
+// El generador solo emite x86-64 (System V: 'valores' llega en rdi y el
+// resultado sale en xmm0); en el resto de las arquitecturas se interpreta
+#if defined(__x86_64__) && !defined(_WIN32) && !defined(SIN_JIT)
+#define JIT_X86_64 1
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+#ifdef JIT_X86_64
+
+#define JIT_REGISTROS 16
+// Bytes de pila de la función generada. Con una página como máximo no hace
+// falta sondear la pila al reservarla
+#define JIT_MAX_MARCO 4096
+// Ranuras para subexpresiones compartidas; el resto del marco queda para
+// los derrames. Los subárboles compartidos que no caben se recalculan
+#define JIT_MAX_COMPARTIDAS 448
+
+// Registros base de los operandos en memoria
+#define BASE_VALORES 7  // rdi
+#define BASE_PILA 4     // rsp
+
+// Instrucciones SSE2 escalares (F2 0F <código>)
+#define SSE_CARGAR 0x10
+#define SSE_GUARDAR 0x11
+#define SSE_SUMAR 0x58
+#define SSE_MULTIPLICAR 0x59
+
+// ===== Emisión de instrucciones =====
+
+typedef struct {
+    unsigned char *datos;
+    size_t longitud;
+    size_t capacidad;
+    int error;
+} CodigoJit;
+
+static void emitir_bytes(CodigoJit *codigo, const unsigned char *bytes, size_t n) {
+    if (codigo->error) {
+        return;
+    }
+    if (codigo->longitud + n > codigo->capacidad) {
+        size_t capacidad = codigo->capacidad ? codigo->capacidad * 2 : 256;
+        while (capacidad < codigo->longitud + n) {
+            capacidad *= 2;
+        }
+        unsigned char *datos = (unsigned char*)realloc(codigo->datos, capacidad);
+        if (!datos) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para el código nativo\n");
+            codigo->error = 1;
+            return;
+        }
+        codigo->datos = datos;
+        codigo->capacidad = capacidad;
+    }
+    memcpy(codigo->datos + codigo->longitud, bytes, n);
+    codigo->longitud += n;
+}
+
+// <operacion> xmm<destino>, xmm<fuente>
+static void emitir_registros(CodigoJit *codigo, unsigned char operacion, int destino, int fuente) {
+    unsigned char bytes[5];
+    size_t n = 0;
+    bytes[n++] = 0xF2;
+    if (destino >= 8 || fuente >= 8) {
+        bytes[n++] = (unsigned char)(0x40 | (destino >= 8 ? 0x04 : 0) | (fuente >= 8 ? 0x01 : 0));
+    }
+    bytes[n++] = 0x0F;
+    bytes[n++] = operacion;
+    bytes[n++] = (unsigned char)(0xC0 | (destino & 7) << 3 | (fuente & 7));
+    emitir_bytes(codigo, bytes, n);
+}
+
+// <operacion> xmm<registro>, [base + desplazamiento] (en SSE_GUARDAR el
+// destino es la memoria)
+static void emitir_memoria(CodigoJit *codigo, unsigned char operacion, int registro, int base, int32_t desplazamiento) {
+    unsigned char bytes[10];
+    size_t n = 0;
+    bytes[n++] = 0xF2;
+    if (registro >= 8) {
+        bytes[n++] = 0x44;
+    }
+    bytes[n++] = 0x0F;
+    bytes[n++] = operacion;
+    int corto = desplazamiento >= -128 && desplazamiento <= 127;
+    bytes[n++] = (unsigned char)((corto ? 0x40 : 0x80) | (registro & 7) << 3 | base);
+    if (base == BASE_PILA) {
+        bytes[n++] = 0x24; // SIB: [rsp]
+    }
+    if (corto) {
+        bytes[n++] = (unsigned char)(desplazamiento & 0xFF);
+    } else {
+        uint32_t valor = (uint32_t)desplazamiento;
+        for (int i = 0; i < 4; i++) {
+            bytes[n++] = (unsigned char)(valor >> (8 * i));
+        }
+    }
+    emitir_bytes(codigo, bytes, n);
+}
+
+// sub/add rsp, tamano
+static void emitir_ajuste_pila(CodigoJit *codigo, int reservar, uint32_t tamano) {
+    unsigned char bytes[7] = { 0x48, 0x81, (unsigned char)(reservar ? 0xEC : 0xC4) };
+    for (int i = 0; i < 4; i++) {
+        bytes[3 + i] = (unsigned char)(tamano >> (8 * i));
+    }
+    emitir_bytes(codigo, bytes, sizeof(bytes));
+}
+
+// ===== Análisis del DAG =====
+
+// Nodo distinto del árbol o DAG (los paréntesis no cuentan)
+typedef struct {
+    const NodoArbol *nodo;
+    int32_t izquierdo;  // Índices de los hijos (-1 en los identificadores)
+    int32_t derecho;
+    uint32_t usos;      // Padres que lo usan
+    uint32_t etiqueta;  // Registros que necesita (número de Sethi-Ullman)
+    int32_t ranura;     // Subexpresión compartida: su ranura en la pila (-1)
+    uint32_t variable;  // Identificador: índice en 'valores'
+} NodoJit;
+
+typedef struct {
+    FuncionJit *funcion;
+    NodoJit *nodos;
+    uint32_t *orden;     // Nodos en postorden (hijos antes que padres)
+    uint32_t num_nodos;
+    uint32_t capacidad_nodos;
+    uint32_t *casillas;  // Tabla puntero -> índice + 1 (0 = libre)
+    uint32_t capacidad_casillas;
+    CodigoJit codigo;
+    uint32_t ranuras;    // Ranuras de subexpresiones compartidas
+    uint32_t temporales; // Derrames vivos
+    uint32_t max_ranuras;
+    uint32_t derrames;
+} GeneradorJit;
+
+static uint32_t hash_puntero(const NodoArbol *nodo) {
+    uint64_t x = (uint64_t)(uintptr_t)nodo;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+static const NodoArbol* sin_parentesis(const NodoArbol *nodo) {
+    while (nodo->tipo == NODO_PARENTESIS) {
+        nodo = nodo->izquierdo;
+    }
+    return nodo;
+}
+
+static int crecer_casillas(GeneradorJit *g) {
+    uint32_t capacidad = g->capacidad_casillas ? g->capacidad_casillas * 2 : 1024;
+    uint32_t *casillas = (uint32_t*)calloc(capacidad, sizeof(uint32_t));
+    if (!casillas) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < g->num_nodos; i++) {
+        uint32_t c = hash_puntero(g->nodos[i].nodo) & (capacidad - 1);
+        while (casillas[c]) {
+            c = (c + 1) & (capacidad - 1);
+        }
+        casillas[c] = i + 1;
+    }
+    free(g->casillas);
+    g->casillas = casillas;
+    g->capacidad_casillas = capacidad;
+    return 1;
+}
+
+// Índice del nodo 'nodo' (sin paréntesis); lo agrega si es nuevo.
+// Devuelve -1 si falta memoria
+static int32_t buscar_nodo(GeneradorJit *g, const NodoArbol *nodo, int *nuevo) {
+    *nuevo = 0;
+    if ((g->num_nodos + 1) * 2 > g->capacidad_casillas && !crecer_casillas(g)) {
+        return -1;
+    }
+    uint32_t c = hash_puntero(nodo) & (g->capacidad_casillas - 1);
+    while (g->casillas[c]) {
+        if (g->nodos[g->casillas[c] - 1].nodo == nodo) {
+            return (int32_t)(g->casillas[c] - 1);
+        }
+        c = (c + 1) & (g->capacidad_casillas - 1);
+    }
+
+    if (g->num_nodos == g->capacidad_nodos) {
+        uint32_t capacidad = g->capacidad_nodos ? g->capacidad_nodos * 2 : 256;
+        NodoJit *nodos = (NodoJit*)realloc(g->nodos, capacidad * sizeof(NodoJit));
+        if (!nodos) {
+            return -1;
+        }
+        g->nodos = nodos;
+        uint32_t *orden = (uint32_t*)realloc(g->orden, capacidad * sizeof(uint32_t));
+        if (!orden) {
+            return -1;
+        }
+        g->orden = orden;
+        g->capacidad_nodos = capacidad;
+    }
+
+    NodoJit *info = &g->nodos[g->num_nodos];
+    info->nodo = nodo;
+    info->izquierdo = -1;
+    info->derecho = -1;
+    info->usos = 0;
+    info->etiqueta = 1;
+    info->ranura = -1;
+    info->variable = 0;
+    if (nodo->tipo == NODO_IDENTIFICADOR) {
+        // Mismo índice que en el bytecode: la variable ya está internada
+        info->variable = simbolos_internar(&g->funcion->programa.variables, nodo->valor, strlen(nodo->valor));
+    }
+    g->casillas[c] = g->num_nodos + 1;
+    *nuevo = 1;
+    return (int32_t)g->num_nodos++;
+}
+
+// Elemento pendiente del recorrido en postorden
+typedef struct {
+    int32_t nodo;
+    int paso; // 0: sin visitar, 1: izquierdo visitado, 2: ambos visitados
+} PendienteJit;
+
+// Numera los nodos distintos en postorden y cuenta sus usos
+static int recorrer(GeneradorJit *g, const NodoArbol *raiz) {
+    int nuevo;
+    int32_t inicial = buscar_nodo(g, sin_parentesis(raiz), &nuevo);
+    if (inicial < 0) {
+        return 0;
+    }
+
+    int capacidad = 64, cantidad = 0;
+    PendienteJit *pila = (PendienteJit*)malloc(capacidad * sizeof(PendienteJit));
+    if (!pila) {
+        return 0;
+    }
+    pila[cantidad].nodo = inicial;
+    pila[cantidad].paso = 0;
+    cantidad++;
+    uint32_t ordenados = 0;
+
+    while (cantidad > 0) {
+        PendienteJit *actual = &pila[cantidad - 1];
+        const NodoArbol *nodo = g->nodos[actual->nodo].nodo;
+        if (nodo->tipo == NODO_IDENTIFICADOR || actual->paso == 2) {
+            g->orden[ordenados++] = (uint32_t)actual->nodo;
+            cantidad--;
+            continue;
+        }
+
+        const NodoArbol *hijo = sin_parentesis(actual->paso == 0 ? nodo->izquierdo : nodo->derecho);
+        int32_t indice = buscar_nodo(g, hijo, &nuevo);
+        if (indice < 0) {
+            free(pila);
+            return 0;
+        }
+        if (actual->paso == 0) {
+            g->nodos[actual->nodo].izquierdo = indice;
+        } else {
+            g->nodos[actual->nodo].derecho = indice;
+        }
+        g->nodos[indice].usos++;
+        actual->paso++;
+
+        if (nuevo) {
+            if (cantidad == capacidad) {
+                capacidad *= 2;
+                PendienteJit *nueva = (PendienteJit*)realloc(pila, capacidad * sizeof(PendienteJit));
+                if (!nueva) {
+                    free(pila);
+                    return 0;
+                }
+                pila = nueva;
+            }
+            pila[cantidad].nodo = indice;
+            pila[cantidad].paso = 0;
+            cantidad++;
+        }
+    }
+    free(pila);
+    return 1;
+}
+
+// Un operando que ya está en memoria (una variable o una subexpresión
+// compartida ya calculada) entra directo en la instrucción
+static int en_memoria(const GeneradorJit *g, int32_t indice) {
+    return g->nodos[indice].izquierdo < 0 || g->nodos[indice].ranura >= 0;
+}
+
+// Asigna ranuras a los subárboles compartidos y calcula en postorden cuántos
+// registros necesita cada nodo: con dos hijos en registros, el que necesita
+// más se calcula primero y su valor ocupa un registro mientras se calcula el
+// otro (si necesitan lo mismo, hace falta uno más)
+static void etiquetar(GeneradorJit *g) {
+    for (uint32_t k = 0; k < g->num_nodos; k++) {
+        NodoJit *info = &g->nodos[g->orden[k]];
+        if (info->izquierdo >= 0 && info->usos > 1 && g->ranuras < JIT_MAX_COMPARTIDAS) {
+            info->ranura = (int32_t)g->ranuras++;
+        }
+    }
+    g->max_ranuras = g->ranuras;
+
+    for (uint32_t k = 0; k < g->num_nodos; k++) {
+        NodoJit *info = &g->nodos[g->orden[k]];
+        if (info->izquierdo < 0) {
+            continue;
+        }
+        int memoria_izq = en_memoria(g, info->izquierdo);
+        int memoria_der = en_memoria(g, info->derecho);
+        uint32_t izq = g->nodos[info->izquierdo].etiqueta;
+        uint32_t der = g->nodos[info->derecho].etiqueta;
+        if (memoria_izq && memoria_der) {
+            info->etiqueta = 1;
+        } else if (memoria_der) {
+            info->etiqueta = izq;
+        } else if (memoria_izq) {
+            info->etiqueta = der;
+        } else {
+            info->etiqueta = izq == der ? izq + 1 : (izq > der ? izq : der);
+        }
+    }
+}
+
+// ===== Generación =====
+
+static unsigned char operacion_de(const NodoJit *info) {
+    return info->nodo->tipo == NODO_SUMA ? SSE_SUMAR : SSE_MULTIPLICAR;
+}
+
+// <operacion> xmm<registro>, <operando en memoria>
+static void emitir_operando(GeneradorJit *g, unsigned char operacion, int registro, int32_t indice) {
+    const NodoJit *info = &g->nodos[indice];
+    if (info->izquierdo < 0) {
+        emitir_memoria(&g->codigo, operacion, registro, BASE_VALORES, (int32_t)(info->variable * sizeof(double)));
+    } else {
+        emitir_memoria(&g->codigo, operacion, registro, BASE_PILA, info->ranura * (int32_t)sizeof(double));
+    }
+}
+
+// Marco de la generación iterativa
+typedef struct {
+    int32_t nodo;
+    int32_t dato;  // Operando en memoria, segundo hijo o ranura del derrame
+    int base;      // Registro del resultado; puede usar de 'base' a xmm15
+    int paso;
+} MarcoJit;
+
+// Genera el código que deja en xmm<base> el valor de 'raiz' (calculándolo
+// aunque sea una subexpresión compartida)
+static int generar(GeneradorJit *g, int32_t raiz, int base) {
+    int capacidad = 64, cantidad = 0;
+    MarcoJit *pila = (MarcoJit*)malloc(capacidad * sizeof(MarcoJit));
+    if (!pila) {
+        return 0;
+    }
+    pila[cantidad].nodo = raiz;
+    pila[cantidad].dato = -1;
+    pila[cantidad].base = base;
+    pila[cantidad].paso = 0;
+    cantidad++;
+
+    while (cantidad > 0 && !g->codigo.error) {
+        MarcoJit *marco = &pila[cantidad - 1];
+        const NodoJit *info = &g->nodos[marco->nodo];
+        int32_t hijo = -1;
+        int base_hijo = marco->base;
+
+        switch (marco->paso) {
+            case 0:
+                if (info->izquierdo < 0 || (info->ranura >= 0 && marco->nodo != raiz)) {
+                    emitir_operando(g, SSE_CARGAR, marco->base, marco->nodo);
+                    cantidad--;
+                } else if (en_memoria(g, info->derecho)) {
+                    marco->dato = info->derecho;
+                    marco->paso = 1;
+                    hijo = info->izquierdo;
+                } else if (en_memoria(g, info->izquierdo)) {
+                    // + y * son conmutativos (también en coma flotante)
+                    marco->dato = info->izquierdo;
+                    marco->paso = 1;
+                    hijo = info->derecho;
+                } else {
+                    int derecho_primero = g->nodos[info->derecho].etiqueta > g->nodos[info->izquierdo].etiqueta;
+                    hijo = derecho_primero ? info->derecho : info->izquierdo;
+                    marco->dato = derecho_primero ? info->izquierdo : info->derecho;
+                    marco->paso = 2;
+                }
+                break;
+            case 1:
+                emitir_operando(g, operacion_de(info), marco->base, marco->dato);
+                cantidad--;
+                break;
+            case 2:
+                hijo = marco->dato;
+                if (marco->base + 1 < JIT_REGISTROS &&
+                    g->nodos[hijo].etiqueta <= (uint32_t)(JIT_REGISTROS - marco->base - 1)) {
+                    base_hijo = marco->base + 1;
+                    marco->paso = 3;
+                } else {
+                    // Sin registros para el segundo: el primero espera en la pila
+                    uint32_t ranura = g->ranuras + g->temporales++;
+                    if (g->ranuras + g->temporales > g->max_ranuras) {
+                        g->max_ranuras = g->ranuras + g->temporales;
+                    }
+                    g->derrames++;
+                    emitir_memoria(&g->codigo, SSE_GUARDAR, marco->base, BASE_PILA, (int32_t)(ranura * sizeof(double)));
+                    marco->dato = (int32_t)ranura;
+                    marco->paso = 4;
+                }
+                break;
+            case 3:
+                emitir_registros(&g->codigo, operacion_de(info), marco->base, marco->base + 1);
+                cantidad--;
+                break;
+            default:
+                emitir_memoria(&g->codigo, operacion_de(info), marco->base, BASE_PILA,
+                               marco->dato * (int32_t)sizeof(double));
+                g->temporales--;
+                cantidad--;
+                break;
+        }
+
+        if (hijo >= 0) {
+            if (cantidad == capacidad) {
+                capacidad *= 2;
+                MarcoJit *nueva = (MarcoJit*)realloc(pila, capacidad * sizeof(MarcoJit));
+                if (!nueva) {
+                    free(pila);
+                    return 0;
+                }
+                pila = nueva;
+            }
+            pila[cantidad].nodo = hijo;
+            pila[cantidad].dato = -1;
+            pila[cantidad].base = base_hijo;
+            pila[cantidad].paso = 0;
+            cantidad++;
+        }
+    }
+    free(pila);
+    return !g->codigo.error;
+}
+
+// Copia el código a una página nueva y la deja solo de lectura y ejecución
+static int instalar(FuncionJit *funcion, const CodigoJit *codigo) {
+    long pagina = sysconf(_SC_PAGESIZE);
+    size_t tamano = pagina > 0 ? (codigo->longitud + (size_t)pagina - 1) / (size_t)pagina * (size_t)pagina
+                               : codigo->longitud;
+    void *memoria = mmap(NULL, tamano, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memoria == MAP_FAILED) {
+        return 0;
+    }
+    memcpy(memoria, codigo->datos, codigo->longitud);
+    if (mprotect(memoria, tamano, PROT_READ | PROT_EXEC) != 0) {
+        munmap(memoria, tamano);
+        return 0;
+    }
+    funcion->pagina = memoria;
+    funcion->tamano_pagina = tamano;
+    funcion->tamano_codigo = codigo->longitud;
+    funcion->nativa = (FuncionNativa)memoria;
+    return 1;
+}
+
+static int generar_nativo(FuncionJit *funcion, const NodoArbol *raiz) {
+    GeneradorJit g;
+    memset(&g, 0, sizeof(g));
+    g.funcion = funcion;
+
+    int correcto = recorrer(&g, raiz);
+    if (correcto) {
+        etiquetar(&g);
+        // Primero las subexpresiones compartidas (el postorden garantiza que
+        // las que usa cada una ya están calculadas), después la raíz
+        for (uint32_t k = 0; k < g.num_nodos && correcto; k++) {
+            const NodoJit *info = &g.nodos[g.orden[k]];
+            if (info->ranura >= 0) {
+                correcto = generar(&g, (int32_t)g.orden[k], 0);
+                emitir_memoria(&g.codigo, SSE_GUARDAR, 0, BASE_PILA, info->ranura * (int32_t)sizeof(double));
+            }
+        }
+        correcto = correcto && generar(&g, 0, 0);
+    }
+
+    // Marco alineado a 16 bytes; si no cabe en una página se interpreta
+    uint32_t marco = (g.max_ranuras * (uint32_t)sizeof(double) + 15) & ~15u;
+    correcto = correcto && !g.codigo.error && marco <= JIT_MAX_MARCO;
+
+    CodigoJit final = { NULL, 0, 0, 0 };
+    if (correcto) {
+        if (marco) {
+            emitir_ajuste_pila(&final, 1, marco);
+        }
+        emitir_bytes(&final, g.codigo.datos, g.codigo.longitud);
+        if (marco) {
+            emitir_ajuste_pila(&final, 0, marco);
+        }
+        static const unsigned char retorno = 0xC3;
+        emitir_bytes(&final, &retorno, 1);
+        correcto = !final.error && instalar(funcion, &final);
+    }
+    if (correcto) {
+        funcion->subexpresiones = g.ranuras;
+        funcion->derrames = g.derrames;
+    }
+
+    free(final.datos);
+    free(g.codigo.datos);
+    free(g.nodos);
+    free(g.orden);
+    free(g.casillas);
+    return correcto;
+}
+
+#endif // JIT_X86_64
+
+int jit_compilar(FuncionJit *funcion, const NodoArbol *raiz) {
+    funcion->nativa = NULL;
+    funcion->pagina = NULL;
+    funcion->tamano_pagina = 0;
+    funcion->tamano_codigo = 0;
+    funcion->subexpresiones = 0;
+    funcion->derrames = 0;
+    if (!programa_compilar(&funcion->programa, raiz)) {
+        return 0;
+    }
+#ifdef JIT_X86_64
+    generar_nativo(funcion, raiz);
+#endif
+    return 1;
+}
+
+void jit_liberar(FuncionJit *funcion) {
+#ifdef JIT_X86_64
+    if (funcion->pagina) {
+        munmap(funcion->pagina, funcion->tamano_pagina);
+    }
+#endif
+    funcion->pagina = NULL;
+    funcion->nativa = NULL;
+    programa_liberar(&funcion->programa);
+}
+
+double jit_evaluar(const FuncionJit *funcion, const double *valores) {
+    if (funcion->nativa) {
+        return funcion->nativa(valores);
+    }
+    return programa_evaluar(&funcion->programa, valores);
+}
+
+int jit_disponible(void) {
+#ifdef JIT_X86_64
+    return 1;
+#else
+    return 0;
+#endif
+}
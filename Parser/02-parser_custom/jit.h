@@ -0,0 +1,40 @@
+#ifndef JIT_H
+#define JIT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "bytecode.h"
+
+// Compilación del árbol (o DAG) a código máquina x86-64. La función
+// generada recibe el mismo arreglo de valores que programa_evaluar (un
+// double por variable, en el orden de 'programa.variables') y devuelve el
+// resultado en xmm0. Los operandos viven en los 16 registros xmm, asignados
+// con el número de Sethi-Ullman de cada subárbol; los subárboles compartidos
+// de un DAG se calculan una sola vez y se guardan en la pila.
+// En otras arquitecturas (o con -DSIN_JIT, o si el sistema no permite
+// memoria ejecutable) la evaluación usa el bytecode interpretado
+typedef double (*FuncionNativa)(const double *valores);
+
+typedef struct {
+    Programa programa;        // Variables y evaluación interpretada de respaldo
+    FuncionNativa nativa;     // NULL si no hay código nativo
+    void *pagina;             // Memoria ejecutable (mmap)
+    size_t tamano_pagina;
+    size_t tamano_codigo;     // Bytes de código generado
+    uint32_t subexpresiones;  // Subárboles compartidos calculados una sola vez
+    uint32_t derrames;        // Valores guardados en la pila por falta de registros
+} FuncionJit;
+
+// Compila 'raiz'. Devuelve 0 solo si falla la compilación a bytecode; si no
+// se puede generar código nativo la función queda interpretada
+int jit_compilar(FuncionJit *funcion, const NodoArbol *raiz);
+void jit_liberar(FuncionJit *funcion);
+
+// Evalúa con valores[i] como valor de la variable i. Se puede llamar desde
+// varios hilos a la vez
+double jit_evaluar(const FuncionJit *funcion, const double *valores);
+
+// 1 si esta compilación genera código nativo
+int jit_disponible(void);
+
+#endif // JIT_H
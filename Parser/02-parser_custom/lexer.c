@@ -1,69 +1,93 @@
 #include "lexer.h"
+#include "escaneo.h"
+#include "dfa_expresiones.h"
+
+// Correspondencia entre los tokens del DFA generado y TipoToken
+static const TipoToken token_de_dfa[] = {
+    [DFA_EXPR_IDENTIFICADOR] = TOKEN_IDENTIFICADOR,
+    [DFA_EXPR_SUMA] = TOKEN_SUMA,
+    [DFA_EXPR_MULTIPLICACION] = TOKEN_MULTIPLICACION,
+    [DFA_EXPR_PAREN_IZQ] = TOKEN_PAREN_IZQ,
+    [DFA_EXPR_PAREN_DER] = TOKEN_PAREN_DER,
+    [DFA_EXPR_ESPACIO] = TOKEN_ERROR
+};
+
+// Indica si 'c' comienza un identificador según las tablas del DFA
+static int inicia_identificador(char c) {
+    int estado = dfa_transicion(&DFA_EXPR_TABLAS, DFA_ESTADO_INICIAL, (unsigned char)c);
+    return DFA_EXPR_token[estado] == DFA_EXPR_IDENTIFICADOR;
+}
 
 Lexer* crear_lexer(const char *entrada) {
+    return crear_lexer_n(entrada, strlen(entrada));
+}
+
+// La entrada puede no terminar en '\0' (por ejemplo, una línea de un archivo mapeado)
+Lexer* crear_lexer_n(const char *entrada, int longitud) {
     Lexer *lexer = (Lexer*)malloc(sizeof(Lexer));
     if (!lexer) {
         fprintf(stderr, "Error: No se pudo asignar memoria para el lexer\n");
         return NULL;
     }
     
-    lexer->longitud = strlen(entrada);
-    lexer->entrada = (char*)malloc(lexer->longitud + 1);
-    if (!lexer->entrada) {
-        fprintf(stderr, "Error: No se pudo asignar memoria para la entrada\n");
-        free(lexer);
-        return NULL;
-    }
-    
-    strcpy(lexer->entrada, entrada);
+    lexer->separadores = 0;
+    reiniciar_lexer(lexer, entrada, longitud);
+    return lexer;
+}
+
+// Apunta el lexer a una entrada nueva, desde la línea 1, columna 1 (el modo
+// 'separadores' no cambia)
+void reiniciar_lexer(Lexer *lexer, const char *entrada, int longitud) {
+    // La entrada no se copia: los tokens son vistas sobre ella
+    lexer->entrada = entrada;
+    lexer->longitud = longitud;
     lexer->posicion = 0;
     lexer->linea = 1;
     lexer->columna = 1;
-    
-    return lexer;
 }
 
 void liberar_lexer(Lexer *lexer) {
-    if (lexer) {
-        if (lexer->entrada) {
-            free(lexer->entrada);
-        }
-        free(lexer);
-    }
+    free(lexer);
 }
 
 void saltar_espacios(Lexer *lexer) {
-    while (lexer->posicion < lexer->longitud) {
-        char c = lexer->entrada[lexer->posicion];
-        
-        if (c == ' ' || c == '\t') {
-            lexer->posicion++;
-            lexer->columna++;
-        } else if (c == '\n') {
-            lexer->posicion++;
+    // Entre tokens casi siempre hay cero o un blanco: esos casos se
+    // resuelven aquí, sin preparar los registros del núcleo SIMD
+    const char *actual = lexer->entrada + lexer->posicion;
+    int restantes = lexer->longitud - lexer->posicion;
+    if (restantes == 0 || (actual[0] != ' ' && actual[0] != '\t' && actual[0] != '\n')) {
+        return;
+    }
+    if (restantes == 1 || (actual[1] != ' ' && actual[1] != '\t' && actual[1] != '\n')) {
+        lexer->posicion++;
+        if (actual[0] == '\n') {
             lexer->linea++;
             lexer->columna = 1;
         } else {
-            break;
+            lexer->columna++;
         }
+        return;
+    }
+    
+    RachaEspacios racha = escanear_espacios(lexer->entrada + lexer->posicion,
+                                            lexer->longitud - lexer->posicion);
+    
+    lexer->posicion += (int)racha.longitud;
+    if (racha.saltos > 0) {
+        lexer->linea += racha.saltos;
+        lexer->columna = 1 + (int)(racha.longitud - racha.despues_ultimo_salto);
+    } else {
+        lexer->columna += (int)racha.longitud;
     }
 }
 
-Token crear_token(TipoToken tipo, const char *valor, int linea, int columna) {
+Token crear_token(TipoToken tipo, int inicio, int longitud, int linea, int columna) {
     Token token;
     token.tipo = tipo;
+    token.inicio = inicio;
+    token.longitud = longitud;
     token.linea = linea;
     token.columna = columna;
-    
-    if (valor) {
-        token.valor = (char*)malloc(strlen(valor) + 1);
-        if (token.valor) {
-            strcpy(token.valor, valor);
-        }
-    } else {
-        token.valor = NULL;
-    }
-    
     return token;
 }
 
@@ -73,88 +97,93 @@ Token leer_identificador(Lexer *lexer) {
     int columna = lexer->columna;
     
     // Leer el primer carácter (debe ser letra)
-    if (!isalpha(lexer->entrada[lexer->posicion])) {
-        return crear_token(TOKEN_ERROR, "Identificador debe comenzar con letra", linea, columna);
+    if (!inicia_identificador(lexer->entrada[lexer->posicion])) {
+        lexer->posicion++;
+        lexer->columna++;
+        return crear_token(TOKEN_ERROR, inicio, 1, linea, columna);
     }
     
     // Leer el resto del identificador
-    while (lexer->posicion < lexer->longitud) {
-        char c = lexer->entrada[lexer->posicion];
-        if (isalnum(c) || c == '_') {
-            lexer->posicion++;
-            lexer->columna++;
-        } else {
-            break;
-        }
-    }
+    int longitud = (int)escanear_identificador(lexer->entrada + inicio, lexer->longitud - inicio);
+    lexer->posicion += longitud;
+    lexer->columna += longitud;
     
-    // Extraer el identificador
-    int longitud = lexer->posicion - inicio;
-    char *identificador = (char*)malloc(longitud + 1);
-    if (!identificador) {
-        return crear_token(TOKEN_ERROR, "Error de memoria", linea, columna);
-    }
-    
-    strncpy(identificador, &lexer->entrada[inicio], longitud);
-    identificador[longitud] = '\0';
+    return crear_token(TOKEN_IDENTIFICADOR, inicio, lexer->posicion - inicio, linea, columna);
+}
+
+// Salta espacios y comentarios entre sentencias. Si en el camino hubo un
+// salto de línea devuelve 1 y deja en 'token' el fin de sentencia, en la
+// posición del primer salto
+static int saltar_entre_sentencias(Lexer *lexer, Token *token) {
+    int posicion = lexer->posicion;
+    int linea = lexer->linea;
+    int columna = lexer->columna;
     
-    Token token = crear_token(TOKEN_IDENTIFICADOR, identificador, linea, columna);
-    free(identificador);
+    saltar_espacios(lexer);
+    while (lexer->posicion < lexer->longitud && lexer->columna == 1 && lexer->entrada[lexer->posicion] == '#') {
+        const char *salto = memchr(lexer->entrada + lexer->posicion, '\n', lexer->longitud - lexer->posicion);
+        int fin = salto ? (int)(salto - lexer->entrada) : lexer->longitud;
+        lexer->columna += fin - lexer->posicion;
+        lexer->posicion = fin;
+        saltar_espacios(lexer);
+    }
     
-    return token;
+    if (lexer->linea == linea) {
+        return 0;
+    }
+    // Con un solo salto (lo normal) su posición sale de la columna actual;
+    // con varios hay que buscar el primero
+    int desplazamiento;
+    if (lexer->linea == linea + 1) {
+        desplazamiento = lexer->posicion - lexer->columna - posicion;
+    } else {
+        const char *salto = memchr(lexer->entrada + posicion, '\n', lexer->posicion - posicion);
+        desplazamiento = (int)(salto - (lexer->entrada + posicion));
+    }
+    *token = crear_token(TOKEN_FIN_SENTENCIA, posicion + desplazamiento, 1, linea, columna + desplazamiento);
+    return 1;
 }
 
 Token obtener_siguiente_token(Lexer *lexer) {
-    saltar_espacios(lexer);
+    if (lexer->separadores) {
+        Token fin_sentencia;
+        if (saltar_entre_sentencias(lexer, &fin_sentencia)) {
+            return fin_sentencia;
+        }
+        if (lexer->posicion < lexer->longitud && lexer->entrada[lexer->posicion] == ';') {
+            Token token = crear_token(TOKEN_FIN_SENTENCIA, lexer->posicion, 1, lexer->linea, lexer->columna);
+            lexer->posicion++;
+            lexer->columna++;
+            return token;
+        }
+    } else {
+        saltar_espacios(lexer);
+    }
     
     if (lexer->posicion >= lexer->longitud) {
-        return crear_token(TOKEN_EOF, NULL, lexer->linea, lexer->columna);
+        return crear_token(TOKEN_EOF, lexer->posicion, 0, lexer->linea, lexer->columna);
     }
     
-    char c = lexer->entrada[lexer->posicion];
-    int linea = lexer->linea;
-    int columna = lexer->columna;
+    int inicio = lexer->posicion;
     
-    switch (c) {
-        case '+':
-            lexer->posicion++;
-            lexer->columna++;
-            return crear_token(TOKEN_SUMA, "+", linea, columna);
-            
-        case '*':
-            lexer->posicion++;
-            lexer->columna++;
-            return crear_token(TOKEN_MULTIPLICACION, "*", linea, columna);
-            
-        case '(':
-            lexer->posicion++;
-            lexer->columna++;
-            return crear_token(TOKEN_PAREN_IZQ, "(", linea, columna);
-            
-        case ')':
-            lexer->posicion++;
-            lexer->columna++;
-            return crear_token(TOKEN_PAREN_DER, ")", linea, columna);
-            
-        default:
-            if (isalpha(c)) {
-                return leer_identificador(lexer);
-            } else {
-                // Carácter no reconocido
-                char error_msg[100];
-                snprintf(error_msg, sizeof(error_msg), "Carácter no reconocido: '%c'", c);
-                lexer->posicion++;
-                lexer->columna++;
-                return crear_token(TOKEN_ERROR, error_msg, linea, columna);
-            }
+    // El resto de un identificador se recorre con el núcleo SIMD
+    if (inicia_identificador(lexer->entrada[inicio])) {
+        return leer_identificador(lexer);
     }
+    
+    // Operadores, paréntesis y caracteres no reconocidos: tablas del DFA
+    int tipo_dfa;
+    int longitud = (int)dfa_reconocer(&DFA_EXPR_TABLAS, (const unsigned char*)lexer->entrada + inicio,
+                                      lexer->longitud - inicio, &tipo_dfa);
+    Token token = crear_token(tipo_dfa < 0 ? TOKEN_ERROR : token_de_dfa[tipo_dfa],
+                              inicio, longitud, lexer->linea, lexer->columna);
+    lexer->posicion += longitud;
+    lexer->columna += longitud;
+    return token;
 }
 
-void liberar_token(Token *token) {
-    if (token && token->valor) {
-        free(token->valor);
-        token->valor = NULL;
-    }
+const char* token_texto(const Lexer *lexer, const Token *token) {
+    return lexer->entrada + token->inicio;
 }
 
 char* tipo_token_a_string(TipoToken tipo) {
@@ -166,14 +195,15 @@ char* tipo_token_a_string(TipoToken tipo) {
         case TOKEN_PAREN_DER: return "PAREN_DER";
         case TOKEN_EOF: return "EOF";
         case TOKEN_ERROR: return "ERROR";
+        case TOKEN_FIN_SENTENCIA: return "FIN_SENTENCIA";
         default: return "DESCONOCIDO";
     }
 }
 
-void imprimir_token(Token *token) {
+void imprimir_token(const Lexer *lexer, const Token *token) {
     printf("Token: %s", tipo_token_a_string(token->tipo));
-    if (token->valor) {
-        printf(" [%s]", token->valor);
+    if (token->longitud > 0) {
+        printf(" [%.*s]", token->longitud, token_texto(lexer, token));
     }
     printf(" en línea %d, columna %d\n", token->linea, token->columna);
 }
\ No newline at end of file
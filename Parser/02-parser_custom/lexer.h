@@ -14,37 +14,48 @@ typedef enum {
     TOKEN_PAREN_IZQ,
     TOKEN_PAREN_DER,
     TOKEN_EOF,
-    TOKEN_ERROR
+    TOKEN_ERROR,
+    TOKEN_FIN_SENTENCIA   // Salto de línea o ';' (solo con 'separadores')
 } TipoToken;
 
 // Estructura para un token
+// El lexema no se copia: es la vista entrada[inicio, inicio + longitud)
+// sobre la cadena que recibió el lexer
 typedef struct {
     TipoToken tipo;
-    char *valor;
+    int inicio;
+    int longitud;
     int linea;
     int columna;
 } Token;
 
 // Estructura para el lexer
+// La entrada pertenece a quien llama y debe seguir viva mientras se use el lexer.
+// Con 'separadores' (0 por defecto) el lexer lee una secuencia de sentencias:
+// ';' y los saltos de línea dan TOKEN_FIN_SENTENCIA (uno por cada racha de
+// blancos con saltos) y una línea que empieza con '#' es un comentario
 typedef struct {
-    char *entrada;
+    const char *entrada;
     int posicion;
     int linea;
     int columna;
     int longitud;
+    int separadores;
 } Lexer;
 
 // Funciones del lexer
 Lexer* crear_lexer(const char *entrada);
+Lexer* crear_lexer_n(const char *entrada, int longitud);
 void liberar_lexer(Lexer *lexer);
+void reiniciar_lexer(Lexer *lexer, const char *entrada, int longitud);
 Token obtener_siguiente_token(Lexer *lexer);
-void liberar_token(Token *token);
+const char* token_texto(const Lexer *lexer, const Token *token);
 char* tipo_token_a_string(TipoToken tipo);
-void imprimir_token(Token *token);
+void imprimir_token(const Lexer *lexer, const Token *token);
 
 // Funciones auxiliares
 void saltar_espacios(Lexer *lexer);
-Token crear_token(TipoToken tipo, const char *valor, int linea, int columna);
+Token crear_token(TipoToken tipo, int inicio, int longitud, int linea, int columna);
 Token leer_identificador(Lexer *lexer);
 
 #endif // LEXER_H
\ No newline at end of file
@@ -0,0 +1,458 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lote.h"
+#include "pool.h"
+
+// Tamaño aproximado de un bloque de trabajo; cada bloque termina en un salto de línea
+#define TAMANO_BLOQUE_LOTE (64 * 1024)
+// Bloques en vuelo por hilo: limita la memoria de salida pendiente de escribir
+#define BLOQUES_POR_HILO 4
+
+// Con 'reutilizable' la entrada se analiza reiniciando ese parser; si no,
+// con un parser nuevo sobre 'simbolos'
+static int procesar(Salida *salida, Parser *reutilizable, TablaSimbolos *simbolos, const OpcionesLote *opciones,
+                    int numero_linea, const char *entrada, size_t longitud) {
+    const EmisorArbol *emisor = opciones->solo_contar ? NULL : opciones->emisor;
+    if (emisor) {
+        emisor->inicio(salida, numero_linea, entrada, longitud);
+    }
+    
+    // Con cache, un acierto repite la salida guardada sin analizar de nuevo
+    CacheAnalisis *cache = opciones->cache && opciones->cache->emisor == emisor ? opciones->cache : NULL;
+    int valida;
+    if (cache && cache_reproducir(cache, salida, entrada, longitud, &valida)) {
+        if (emisor) {
+            emisor->fin(salida);
+        }
+        return valida;
+    }
+    
+    Parser *parser = reutilizable;
+    if (parser) {
+        reiniciar_parser(parser, entrada, (int)longitud);
+    } else {
+        parser = crear_parser_con_simbolos(entrada, (int)longitud, simbolos);
+    }
+    if (!parser) {
+        if (emisor) {
+            emisor->error(salida, "Error: No se pudo crear el parser");
+            emisor->fin(salida);
+        }
+        return 0;
+    }
+    
+    NodoArbol *arbol = analizar(parser);
+    valida = arbol != NULL;
+    
+    size_t inicio_resultado = salida->longitud;
+    if (emisor) {
+        if (arbol) {
+            emisor->arbol(salida, arbol);
+        } else {
+            emisor->error(salida, parser->mensaje_error);
+        }
+    }
+    // Con --count la entrada se guarda sin salida: solo si es válida
+    if (cache) {
+        cache_guardar(cache, entrada, longitud, arbol, parser->mensaje_error,
+                      emisor ? salida->datos + inicio_resultado : NULL, salida->longitud - inicio_resultado);
+    }
+    if (emisor) {
+        emisor->fin(salida);
+    }
+    
+    liberar_arbol(arbol);
+    if (parser != reutilizable) {
+        liberar_parser(parser);
+    }
+    return valida;
+}
+
+int procesar_entrada_n(Salida *salida, TablaSimbolos *simbolos, const OpcionesLote *opciones,
+                       int numero_linea, const char *entrada, size_t longitud) {
+    return procesar(salida, NULL, simbolos, opciones, numero_linea, entrada, longitud);
+}
+
+int procesar_entrada_con_parser(Salida *salida, Parser *parser, const OpcionesLote *opciones,
+                                int numero_linea, const char *entrada, size_t longitud) {
+    return procesar(salida, parser, NULL, opciones, numero_linea, entrada, longitud);
+}
+
+void imprimir_totales(long lineas, long validas) {
+    printf("lineas=%ld validas=%ld errores=%ld\n", lineas, validas, lineas - validas);
+}
+
+// Contenido completo de un archivo: mapeado en memoria o, si no se puede
+// mapear (tuberías, dispositivos), leído en un buffer propio
+typedef struct {
+    char *datos;
+    size_t longitud;
+    int mapeado;
+} ContenidoArchivo;
+
+static int cargar_archivo(const char *nombre_archivo, ContenidoArchivo *contenido) {
+    int fd = open(nombre_archivo, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    
+    contenido->datos = NULL;
+    contenido->longitud = 0;
+    contenido->mapeado = 0;
+    
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        contenido->longitud = (size_t)info.st_size;
+        if (contenido->longitud == 0) {
+            close(fd);
+            return 1;
+        }
+        void *mapa = mmap(NULL, contenido->longitud, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapa != MAP_FAILED) {
+            posix_madvise(mapa, contenido->longitud, POSIX_MADV_SEQUENTIAL);
+            contenido->datos = (char*)mapa;
+            contenido->mapeado = 1;
+            close(fd);
+            return 1;
+        }
+        contenido->longitud = 0;
+    }
+    
+    size_t capacidad = 0;
+    ssize_t leidos;
+    do {
+        if (contenido->longitud == capacidad) {
+            capacidad = capacidad ? capacidad * 2 : 1 << 16;
+            char *nuevo = (char*)realloc(contenido->datos, capacidad);
+            if (!nuevo) {
+                free(contenido->datos);
+                close(fd);
+                return 0;
+            }
+            contenido->datos = nuevo;
+        }
+        leidos = read(fd, contenido->datos + contenido->longitud, capacidad - contenido->longitud);
+        if (leidos > 0) {
+            contenido->longitud += (size_t)leidos;
+        }
+    } while (leidos > 0);
+    
+    close(fd);
+    return leidos == 0;
+}
+
+static void liberar_archivo(ContenidoArchivo *contenido) {
+    if (contenido->mapeado) {
+        munmap(contenido->datos, contenido->longitud);
+    } else {
+        free(contenido->datos);
+    }
+}
+
+static double segundos_actuales(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Rango de líneas del archivo que se procesa como una unidad
+typedef struct {
+    const char *inicio;
+    const char *fin;
+    int primera_linea;
+    long lineas_analizadas;
+    long lineas_validas;
+    int terminado;
+    Salida salida;
+} BloqueLote;
+
+// Estado compartido del procesamiento en paralelo: ventana circular de bloques
+typedef struct {
+    BloqueLote *bloques;
+    size_t ventana;
+    const OpcionesLote *opciones;
+    pthread_mutex_t mutex;
+    pthread_cond_t bloque_terminado;
+} Lote;
+
+// Analiza cada línea del bloque sin copiarla: cada línea se entrega al
+// parser como una vista sobre el contenido del archivo. Las líneas del bloque
+// comparten una tabla de símbolos, así cada nombre se guarda una vez por
+// bloque, y un mismo parser que se reinicia en cada línea
+static void procesar_bloque(BloqueLote *bloque, const OpcionesLote *opciones) {
+    const char *cursor = bloque->inicio;
+    int numero_linea = bloque->primera_linea;
+    bloque->lineas_analizadas = 0;
+    bloque->lineas_validas = 0;
+    
+    TablaSimbolos simbolos;
+    simbolos_iniciar(&simbolos);
+    Parser *parser = crear_parser_con_simbolos("", 0, &simbolos);
+    
+    while (cursor < bloque->fin) {
+        const char *salto = memchr(cursor, '\n', (size_t)(bloque->fin - cursor));
+        const char *fin_linea = salto ? salto : bloque->fin;
+        size_t longitud = (size_t)(fin_linea - cursor);
+        
+        // Saltar líneas vacías y comentarios
+        if (longitud > 0 && cursor[0] != '#') {
+            if (longitud > INT_MAX) {
+                const EmisorArbol *emisor = opciones->solo_contar ? NULL : opciones->emisor;
+                if (emisor) {
+                    emisor->inicio(&bloque->salida, numero_linea, cursor, 0);
+                    emisor->error(&bloque->salida, "Error: la línea supera el tamaño máximo admitido");
+                    emisor->fin(&bloque->salida);
+                }
+            } else {
+                bloque->lineas_validas += procesar(&bloque->salida, parser, &simbolos, opciones,
+                                                   numero_linea, cursor, longitud);
+            }
+            bloque->lineas_analizadas++;
+        }
+        
+        numero_linea++;
+        cursor = salto ? salto + 1 : bloque->fin;
+    }
+    
+    liberar_parser(parser);
+    simbolos_liberar(&simbolos);
+}
+
+static void ejecutar_bloque(void *contexto, size_t tarea) {
+    Lote *lote = (Lote*)contexto;
+    BloqueLote *bloque = &lote->bloques[tarea % lote->ventana];
+    
+    procesar_bloque(bloque, lote->opciones);
+    
+    pthread_mutex_lock(&lote->mutex);
+    bloque->terminado = 1;
+    pthread_cond_broadcast(&lote->bloque_terminado);
+    pthread_mutex_unlock(&lote->mutex);
+}
+
+// Prepara el siguiente bloque a partir de 'cursor' y devuelve dónde termina
+static const char* preparar_bloque(BloqueLote *bloque, const char *cursor, const char *fin, int *numero_linea) {
+    const char *fin_bloque = fin;
+    if ((size_t)(fin - cursor) > TAMANO_BLOQUE_LOTE) {
+        const char *salto = memchr(cursor + TAMANO_BLOQUE_LOTE, '\n', (size_t)(fin - cursor - TAMANO_BLOQUE_LOTE));
+        fin_bloque = salto ? salto + 1 : fin;
+    }
+    
+    bloque->inicio = cursor;
+    bloque->fin = fin_bloque;
+    bloque->primera_linea = *numero_linea;
+    bloque->terminado = 0;
+    
+    for (const char *p = cursor; (p = memchr(p, '\n', (size_t)(fin_bloque - p))) != NULL; p++) {
+        (*numero_linea)++;
+    }
+    
+    return fin_bloque;
+}
+
+// Ambos modos devuelven las líneas analizadas y, en 'validas', las correctas
+static long procesar_secuencial(const char *datos, size_t longitud, const OpcionesLote *opciones, long *validas) {
+    BloqueLote bloque;
+    salida_iniciar(&bloque.salida);
+    
+    const char *cursor = datos;
+    const char *fin = datos + longitud;
+    int numero_linea = 1;
+    long lineas = 0;
+    
+    while (cursor < fin) {
+        cursor = preparar_bloque(&bloque, cursor, fin, &numero_linea);
+        procesar_bloque(&bloque, opciones);
+        salida_volcar(&bloque.salida, stdout);
+        lineas += bloque.lineas_analizadas;
+        *validas += bloque.lineas_validas;
+    }
+    
+    salida_liberar(&bloque.salida);
+    return lineas;
+}
+
+// Reparte los bloques en un pool con robo de trabajo y escribe sus salidas
+// en el orden original a medida que terminan
+static long procesar_paralelo(const char *datos, size_t longitud, int hilos, const OpcionesLote *opciones, long *validas) {
+    Lote lote;
+    lote.opciones = opciones;
+    lote.ventana = (size_t)hilos * BLOQUES_POR_HILO;
+    lote.bloques = (BloqueLote*)calloc(lote.ventana, sizeof(BloqueLote));
+    if (!lote.bloques) {
+        return procesar_secuencial(datos, longitud, opciones, validas);
+    }
+    pthread_mutex_init(&lote.mutex, NULL);
+    pthread_cond_init(&lote.bloque_terminado, NULL);
+    
+    Pool *pool = crear_pool(hilos, ejecutar_bloque, &lote);
+    if (!pool) {
+        pthread_mutex_destroy(&lote.mutex);
+        pthread_cond_destroy(&lote.bloque_terminado);
+        free(lote.bloques);
+        return procesar_secuencial(datos, longitud, opciones, validas);
+    }
+    
+    const char *cursor = datos;
+    const char *fin = datos + longitud;
+    int numero_linea = 1;
+    size_t enviados = 0;
+    size_t escritos = 0;
+    long lineas = 0;
+    
+    while (1) {
+        while (cursor < fin && enviados - escritos < lote.ventana) {
+            cursor = preparar_bloque(&lote.bloques[enviados % lote.ventana], cursor, fin, &numero_linea);
+            pool_enviar(pool, enviados++);
+        }
+        if (escritos == enviados) {
+            break;
+        }
+        
+        BloqueLote *bloque = &lote.bloques[escritos % lote.ventana];
+        pthread_mutex_lock(&lote.mutex);
+        while (!bloque->terminado) {
+            pthread_cond_wait(&lote.bloque_terminado, &lote.mutex);
+        }
+        pthread_mutex_unlock(&lote.mutex);
+        
+        salida_volcar(&bloque->salida, stdout);
+        lineas += bloque->lineas_analizadas;
+        *validas += bloque->lineas_validas;
+        escritos++;
+    }
+    
+    liberar_pool(pool);
+    for (size_t i = 0; i < lote.ventana; i++) {
+        salida_liberar(&lote.bloques[i].salida);
+    }
+    pthread_mutex_destroy(&lote.mutex);
+    pthread_cond_destroy(&lote.bloque_terminado);
+    free(lote.bloques);
+    return lineas;
+}
+
+void procesar_archivo(const char *nombre_archivo, int hilos, const OpcionesLote *opciones) {
+    ContenidoArchivo contenido;
+    if (!cargar_archivo(nombre_archivo, &contenido)) {
+        printf("❌ Error: No se pudo abrir el archivo '%s'\n", nombre_archivo);
+        return;
+    }
+    
+    if (hilos <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        hilos = cpus > 0 ? (int)cpus : 1;
+    }
+    
+    // La cabecera y el pie solo acompañan al formato indentado; JSON y
+    // S-expresiones quedan con un registro por línea
+    int con_marco = !opciones->solo_contar && opciones->emisor == &emisor_indentado;
+    if (con_marco) {
+        printf("📁 Procesando archivo: %s\n", nombre_archivo);
+        printf("========================================\n\n");
+    }
+    
+    double inicio = segundos_actuales();
+    long lineas_analizadas;
+    long lineas_validas = 0;
+    if (hilos == 1) {
+        lineas_analizadas = procesar_secuencial(contenido.datos, contenido.longitud, opciones, &lineas_validas);
+    } else {
+        lineas_analizadas = procesar_paralelo(contenido.datos, contenido.longitud, hilos, opciones, &lineas_validas);
+    }
+    double segundos = segundos_actuales() - inicio;
+    
+    liberar_archivo(&contenido);
+    if (con_marco) {
+        printf("✅ Procesamiento del archivo completado\n");
+    } else if (opciones->solo_contar) {
+        imprimir_totales(lineas_analizadas, lineas_validas);
+    }
+    fflush(stdout);
+    
+    // Las estadísticas van a stderr para no alterar la salida del análisis
+    if (segundos > 0) {
+        fprintf(stderr, "📊 %ld líneas, %.2f MB en %.3f s con %d hilo(s) (%.0f líneas/s, %.2f MB/s)\n",
+                lineas_analizadas, contenido.longitud / 1e6, segundos, hilos,
+                lineas_analizadas / segundos, contenido.longitud / 1e6 / segundos);
+    }
+}
+
+// Estado de procesar_archivo_sentencias entre sentencias
+typedef struct {
+    Salida salida;
+    const EmisorArbol *emisor;
+} LoteSentencias;
+
+static void emitir_sentencia(void *contexto, const Sentencia *sentencia) {
+    LoteSentencias *lote = (LoteSentencias*)contexto;
+    if (!lote->emisor) return;
+    
+    lote->emisor->inicio(&lote->salida, sentencia->linea, sentencia->texto, sentencia->longitud);
+    if (sentencia->arbol) {
+        lote->emisor->arbol(&lote->salida, sentencia->arbol);
+    } else {
+        lote->emisor->error(&lote->salida, sentencia->mensaje_error);
+    }
+    lote->emisor->fin(&lote->salida);
+    if (lote->salida.longitud >= TAMANO_BLOQUE_LOTE) {
+        salida_volcar(&lote->salida, stdout);
+    }
+}
+
+void procesar_archivo_sentencias(const char *nombre_archivo, const OpcionesLote *opciones) {
+    ContenidoArchivo contenido;
+    if (!cargar_archivo(nombre_archivo, &contenido)) {
+        printf("❌ Error: No se pudo abrir el archivo '%s'\n", nombre_archivo);
+        return;
+    }
+    if (contenido.longitud > INT_MAX) {
+        printf("❌ Error: el archivo '%s' supera el tamaño máximo admitido\n", nombre_archivo);
+        liberar_archivo(&contenido);
+        return;
+    }
+    
+    LoteSentencias lote;
+    salida_iniciar(&lote.salida);
+    lote.emisor = opciones->solo_contar ? NULL : opciones->emisor;
+    int con_marco = lote.emisor == &emisor_indentado;
+    if (con_marco) {
+        printf("📁 Procesando archivo: %s\n", nombre_archivo);
+        printf("========================================\n\n");
+    }
+    
+    double inicio = segundos_actuales();
+    long sentencias = 0;
+    long errores = 0;
+    Parser *parser = crear_parser_n(contenido.datos ? contenido.datos : "", (int)contenido.longitud);
+    if (parser) {
+        errores = analizar_sentencias(parser, emitir_sentencia, &lote, &sentencias);
+        liberar_parser(parser);
+    }
+    salida_volcar(&lote.salida, stdout);
+    double segundos = segundos_actuales() - inicio;
+    
+    salida_liberar(&lote.salida);
+    liberar_archivo(&contenido);
+    if (!parser) {
+        printf("❌ Error: No se pudo crear el parser\n");
+    } else if (con_marco) {
+        printf("✅ Procesamiento del archivo completado\n");
+    } else if (opciones->solo_contar) {
+        imprimir_totales(sentencias, sentencias - errores);
+    }
+    fflush(stdout);
+    
+    if (segundos > 0) {
+        fprintf(stderr, "📊 %ld sentencias (%ld con errores), %.2f MB en %.3f s en una pasada (%.0f sentencias/s, %.2f MB/s)\n",
+                sentencias, errores, contenido.longitud / 1e6, segundos, sentencias / segundos,
+                contenido.longitud / 1e6 / segundos);
+    }
+}
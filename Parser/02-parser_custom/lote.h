@@ -0,0 +1,46 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include "emisor.h"
+#include "cache.h"
+
+// Procesamiento por lotes: análisis de archivos completos, una expresión por línea
+
+// Cómo se informa cada análisis: con 'emisor' (emisor_indentado por
+// defecto) o, con solo_contar activo, solo con los totales al final. Con
+// 'cache' (NULL: sin cache) las entradas repetidas no se vuelven a analizar;
+// solo se usa si la cache guarda salidas del mismo emisor
+typedef struct {
+    const EmisorArbol *emisor;
+    int solo_contar;
+    CacheAnalisis *cache;
+} OpcionesLote;
+
+// Analiza 'longitud' bytes de 'entrada' (no necesita terminar en '\0')
+// y escribe el resultado en 'salida'; los identificadores se internan en
+// 'simbolos' (NULL: una tabla propia para esta entrada). 'numero_linea' es
+// la línea del archivo (0 fuera de un archivo). Devuelve 1 si es válida
+int procesar_entrada_n(Salida *salida, TablaSimbolos *simbolos, const OpcionesLote *opciones,
+                       int numero_linea, const char *entrada, size_t longitud);
+
+// Igual que procesar_entrada_n, pero reiniciando 'parser' (creado una vez,
+// por ejemplo con crear_parser_con_simbolos("", 0, tabla)) en lugar de crear
+// uno por entrada: un bucle de muchas entradas no reserva memoria por
+// entrada. El árbol de la entrada anterior deja de ser válido
+int procesar_entrada_con_parser(Salida *salida, Parser *parser, const OpcionesLote *opciones,
+                                int numero_linea, const char *entrada, size_t longitud);
+
+// Escribe los totales del modo solo_contar ("lineas=N validas=M errores=K")
+void imprimir_totales(long lineas, long validas);
+
+// Procesa un archivo con 'hilos' hilos (1: secuencial, 0: uno por CPU);
+// la salida es idéntica en todos los casos
+void procesar_archivo(const char *nombre_archivo, int hilos, const OpcionesLote *opciones);
+
+// Analiza el archivo completo en una sola pasada como una secuencia de
+// sentencias separadas por saltos de línea o ';' (analizar_sentencias): un
+// solo lexer y un solo parser para todo el archivo, y un registro del
+// emisor por sentencia, con todos los errores
+void procesar_archivo_sentencias(const char *nombre_archivo, const OpcionesLote *opciones);
+
+#endif // LOTE_H
@@ -1,4 +1,8 @@
-#include "parser.h"
+#include <errno.h>
+#include <limits.h>
+#include "lote.h"
+#include "plano.h"
+#include "nario.h"
 
 void mostrar_ayuda() {
     printf("=== PARSER LL(1) PERSONALIZADO EN C ===\n");
@@ -18,35 +22,154 @@ void mostrar_ayuda() {
     printf("  (a + b) * c\n\n");
 }
 
+// Formato de salida elegido con --formato, --quiet o --count
+static OpcionesLote opciones = { &emisor_indentado, 0, NULL };
+
+// Cache de análisis de --cache (megabytes; 0: sin cache)
+static double megas_cache = 0;
+static CacheAnalisis cache;
+
 void procesar_entrada(const char *entrada) {
-    printf("🔍 Analizando: %s\n", entrada);
-    printf("----------------------------------------\n");
-    
+    Salida salida;
+    salida_iniciar(&salida);
+    int valida = procesar_entrada_n(&salida, NULL, &opciones, 0, entrada, strlen(entrada));
+    salida_volcar(&salida, stdout);
+    salida_liberar(&salida);
+    if (opciones.solo_contar) {
+        imprimir_totales(1, valida);
+    }
+}
+
+// Quita de argv las opciones de formato (pueden ir en cualquier posición)
+// y devuelve el nuevo argc, o -1 si alguna no es válida
+static int leer_opciones_formato(int argc, char *argv[]) {
+    int restantes = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--quiet") == 0 || strcmp(argv[i], "--count") == 0) {
+            opciones.solo_contar = 1;
+        } else if (strcmp(argv[i], "--formato") == 0) {
+            if (i + 1 == argc || !(opciones.emisor = buscar_emisor(argv[i + 1]))) {
+                return -1;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--cache") == 0) {
+            if (i + 1 == argc || (megas_cache = atof(argv[i + 1])) <= 0) {
+                return -1;
+            }
+            i++;
+        } else {
+            argv[restantes++] = argv[i];
+        }
+    }
+    argv[restantes] = NULL;
+    return restantes;
+}
+
+// Cantidad de hilos de -j: un entero no negativo (0: uno por CPU).
+// Devuelve 0 si el texto no lo es
+static int leer_hilos(const char *texto, int *hilos) {
+    char *fin;
+    errno = 0;
+    long valor = strtol(texto, &fin, 10);
+    if (fin == texto || *fin != '\0' || errno == ERANGE || valor < 0 || valor > INT_MAX) {
+        return 0;
+    }
+    *hilos = (int)valor;
+    return 1;
+}
+
+// Analiza una expresión y guarda su árbol en el formato binario plano
+int guardar_arbol(const char *entrada, const char *nombre_archivo) {
     Parser *parser = crear_parser(entrada);
     if (!parser) {
         printf("❌ Error: No se pudo crear el parser\n");
-        return;
+        return 1;
     }
     
     NodoArbol *arbol = analizar(parser);
+    if (!arbol) {
+        Salida salida;
+        salida_iniciar(&salida);
+        imprimir_error(&salida, parser);
+        salida_volcar(&salida, stdout);
+        salida_liberar(&salida);
+        printf("❌ ERROR EN EL ANÁLISIS SINTÁCTICO\n");
+        liberar_parser(parser);
+        return 1;
+    }
     
-    if (arbol) {
-        printf("✅ ANÁLISIS SINTÁCTICO EXITOSO\n");
-        printf("Árbol de análisis sintáctico:\n");
-        imprimir_arbol(arbol, 0);
-        liberar_arbol(arbol);
+    ArbolPlano plano;
+    plano_iniciar(&plano);
+    int correcto = plano_desde_arbol(&plano, arbol) && plano_guardar(&plano, nombre_archivo);
+    if (correcto) {
+        printf("💾 Árbol guardado en %s (%u nodos, %u nombres)\n",
+               nombre_archivo, plano.num_nodos, plano.num_nombres);
     } else {
-        printf("❌ ERROR EN EL ANÁLISIS SINTÁCTICO\n");
+        printf("❌ Error: No se pudo guardar el árbol en %s\n", nombre_archivo);
     }
     
+    plano_liberar(&plano);
+    liberar_arbol(arbol);
     liberar_parser(parser);
-    printf("----------------------------------------\n\n");
+    return correcto ? 0 : 1;
+}
+
+// Mapea un árbol guardado con -g y lo imprime
+int cargar_arbol(const char *nombre_archivo) {
+    ArbolPlano plano;
+    if (!plano_mapear(&plano, nombre_archivo) || !plano_validar(&plano)) {
+        printf("❌ Error: %s no es un árbol plano válido\n", nombre_archivo);
+        plano_liberar(&plano);
+        return 1;
+    }
+    
+    Salida salida;
+    salida_iniciar(&salida);
+    salida_printf(&salida, "📂 Árbol cargado de %s (%u nodos):\n", nombre_archivo, plano.num_nodos);
+    imprimir_arbol_plano(&salida, &plano);
+    salida_volcar(&salida, stdout);
+    salida_liberar(&salida);
+    
+    plano_liberar(&plano);
+    return 0;
+}
+
+// Analiza una expresión e imprime su forma n-aria (reasociando + y *)
+int mostrar_nario(const char *entrada) {
+    Parser *parser = crear_parser(entrada);
+    if (!parser) {
+        printf("❌ Error: No se pudo crear el parser\n");
+        return 1;
+    }
+    
+    Salida salida;
+    salida_iniciar(&salida);
+    NodoArbol *arbol = analizar(parser);
+    ArbolNario nario;
+    nario_iniciar(&nario);
+    int correcto = arbol && nario_desde_arbol(&nario, arbol, 1);
+    if (correcto) {
+        salida_printf(&salida, "🌳 Forma n-aria (%u nodos, profundidad %u):\n", nario.num_nodos, nario.profundidad);
+        imprimir_arbol_nario(&salida, &nario);
+    } else if (!arbol) {
+        imprimir_error(&salida, parser);
+        salida_printf(&salida, "❌ ERROR EN EL ANÁLISIS SINTÁCTICO\n");
+    }
+    salida_volcar(&salida, stdout);
+    salida_liberar(&salida);
+    
+    nario_liberar(&nario);
+    liberar_arbol(arbol);
+    liberar_parser(parser);
+    return correcto ? 0 : 1;
 }
 
 void modo_interactivo() {
     char entrada[256];
     
-    mostrar_ayuda();
+    if (opciones.emisor == &emisor_indentado) {
+        mostrar_ayuda();
+    }
     printf("Modo interactivo - Ingrese expresiones (escriba 'salir' para terminar):\n\n");
     
     while (1) {
@@ -76,59 +199,71 @@ void modo_interactivo() {
     printf("¡Hasta luego!\n");
 }
 
-void procesar_archivo(const char *nombre_archivo) {
-    FILE *archivo = fopen(nombre_archivo, "r");
-    if (!archivo) {
-        printf("❌ Error: No se pudo abrir el archivo '%s'\n", nombre_archivo);
-        return;
-    }
-    
-    printf("📁 Procesando archivo: %s\n", nombre_archivo);
-    printf("========================================\n\n");
-    
-    char linea[256];
-    int numero_linea = 1;
-    
-    while (fgets(linea, sizeof(linea), archivo)) {
-        // Eliminar el salto de línea
-        linea[strcspn(linea, "\n")] = '\0';
-        
-        // Saltar líneas vacías y comentarios
-        if (strlen(linea) == 0 || linea[0] == '#') {
-            numero_linea++;
-            continue;
-        }
-        
-        printf("Línea %d: ", numero_linea);
-        procesar_entrada(linea);
-        numero_linea++;
+int main(int argc, char *argv[]) {
+    // argc queda en -1 si una opción de formato no es válida: se muestra el uso
+    argc = leer_opciones_formato(argc, argv);
+    if (megas_cache > 0) {
+        cache_iniciar(&cache, (size_t)(megas_cache * 1024 * 1024),
+                      opciones.solo_contar ? NULL : opciones.emisor);
+        opciones.cache = &cache;
     }
     
-    fclose(archivo);
-    printf("✅ Procesamiento del archivo completado\n");
-}
-
-int main(int argc, char *argv[]) {
+    int hilos;  // Valor de -j, si es válido
     if (argc == 1) {
         // Modo interactivo
         modo_interactivo();
     } else if (argc == 2) {
         // Procesar archivo
-        procesar_archivo(argv[1]);
+        procesar_archivo(argv[1], 1, &opciones);
+    } else if (argc == 4 && strcmp(argv[1], "-j") == 0 && leer_hilos(argv[2], &hilos)) {
+        // Procesar archivo en paralelo (0: un hilo por CPU)
+        procesar_archivo(argv[3], hilos, &opciones);
+    } else if (argc == 3 && strcmp(argv[1], "-s") == 0) {
+        // Procesar el archivo completo como una secuencia de sentencias
+        procesar_archivo_sentencias(argv[2], &opciones);
     } else if (argc == 3 && strcmp(argv[1], "-e") == 0) {
         // Procesar expresión directa
-        mostrar_ayuda();
+        if (!opciones.solo_contar && opciones.emisor == &emisor_indentado) {
+            mostrar_ayuda();
+        }
         procesar_entrada(argv[2]);
+    } else if (argc == 4 && strcmp(argv[1], "-g") == 0) {
+        // Guardar el árbol en formato binario plano
+        return guardar_arbol(argv[3], argv[2]);
+    } else if (argc == 3 && strcmp(argv[1], "-c") == 0) {
+        // Cargar (mapear) un árbol guardado
+        return cargar_arbol(argv[2]);
+    } else if (argc == 3 && strcmp(argv[1], "-n") == 0) {
+        // Mostrar la forma n-aria
+        return mostrar_nario(argv[2]);
     } else {
         printf("Uso:\n");
         printf("  %s                    # Modo interactivo\n", argv[0]);
         printf("  %s <archivo>          # Procesar archivo\n", argv[0]);
+        printf("  %s -j N <archivo>     # Procesar archivo con N hilos (0: uno por CPU)\n", argv[0]);
+        printf("  %s -s <archivo>       # Procesar el archivo en una pasada (sentencias separadas por salto de línea o ';')\n", argv[0]);
         printf("  %s -e \"expresión\"     # Procesar expresión directa\n", argv[0]);
+        printf("  %s -g <arbol.ast> \"expresión\" # Guardar el árbol en formato binario\n", argv[0]);
+        printf("  %s -c <arbol.ast>     # Cargar e imprimir un árbol guardado\n", argv[0]);
+        printf("  %s -n \"expresión\"     # Imprimir la forma n-aria (cadenas de + y * aplanadas)\n", argv[0]);
+        printf("\nOpciones (en cualquier posición):\n");
+        printf("  --formato indentado|json|sexp  # Formato de los árboles (por defecto indentado)\n");
+        printf("  --quiet, --count               # Solo validar e imprimir los totales\n");
+        printf("  --cache MB                     # Reutilizar el resultado de las entradas repetidas\n");
         printf("\nEjemplos:\n");
         printf("  %s test_input.txt\n", argv[0]);
+        printf("  %s -j 8 test_input.txt\n", argv[0]);
         printf("  %s -e \"a + b * c\"\n", argv[0]);
+        printf("  %s -g arbol.ast \"a + b * c\"\n", argv[0]);
+        printf("  %s --formato json test_input.txt\n", argv[0]);
+        printf("  %s --count -j 0 test_input.txt\n", argv[0]);
+        printf("  %s --cache 64 test_input.txt\n", argv[0]);
         return 1;
     }
     
+    if (opciones.cache) {
+        cache_imprimir_estadisticas(&cache, stderr);
+        cache_liberar(&cache);
+    }
     return 0;
 }
\ No newline at end of file
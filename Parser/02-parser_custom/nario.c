@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "nario.h"
+
+void nario_iniciar(ArbolNario *nario) {
+    memset(nario, 0, sizeof(*nario));
+}
+
+void nario_liberar(ArbolNario *nario) {
+    free(nario->nodos);
+    free(nario->hijos);
+    nario_iniciar(nario);
+}
+
+// Garantiza espacio para 'cantidad' elementos de 'tamano' bytes
+static int reservar(void **arreglo, uint32_t *capacidad, uint32_t cantidad, size_t tamano) {
+    if (cantidad <= *capacidad) {
+        return 1;
+    }
+    uint32_t nueva_capacidad = *capacidad ? *capacidad : 64;
+    while (nueva_capacidad < cantidad) {
+        nueva_capacidad *= 2;
+    }
+    void *nuevo = realloc(*arreglo, (size_t)nueva_capacidad * tamano);
+    if (!nuevo) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el árbol n-ario\n");
+        return 0;
+    }
+    *arreglo = nuevo;
+    *capacidad = nueva_capacidad;
+    return 1;
+}
+
+static const NodoArbol* sin_parentesis(const NodoArbol *nodo) {
+    while (nodo->tipo == NODO_PARENTESIS) {
+        nodo = nodo->izquierdo;
+    }
+    return nodo;
+}
+
+// Agrega el nodo n-ario de 'binario' (sin paréntesis), todavía sin operandos
+static uint32_t agregar_nodo(ArbolNario *nario, const NodoArbol *binario) {
+    if (!reservar((void**)&nario->nodos, &nario->capacidad_nodos, nario->num_nodos + 1, sizeof(NodoNario))) {
+        return UINT32_MAX;
+    }
+    NodoNario *nodo = &nario->nodos[nario->num_nodos];
+    nodo->valor = binario->tipo == NODO_IDENTIFICADOR ? binario->valor : NULL;
+    nodo->primer_hijo = 0;
+    nodo->num_hijos = 0;
+    nodo->simbolo = binario->tipo == NODO_IDENTIFICADOR ? binario->simbolo : SIMBOLO_NINGUNO;
+    nodo->linea = binario->linea;
+    nodo->columna = binario->columna;
+    nodo->tipo = binario->tipo;
+    return nario->num_nodos++;
+}
+
+// Nodo n-ario creado cuyos operandos faltan por reunir
+typedef struct {
+    uint32_t indice;
+    const NodoArbol *binario;
+    uint32_t nivel;
+} PendienteNario;
+
+// Subárbol por recorrer al reunir los operandos de una cadena
+typedef struct {
+    const NodoArbol *nodo;
+    int izquierdo;  // Es el operando izquierdo de su padre en la cadena
+} PendienteCadena;
+
+int nario_desde_arbol(ArbolNario *nario, const NodoArbol *raiz, int reasociar) {
+    nario->num_nodos = 0;
+    nario->num_hijos = 0;
+    nario->profundidad = 0;
+    if (!raiz) return 1;
+
+    PendienteNario *pendientes = NULL;
+    uint32_t num_pendientes = 0, capacidad_pendientes = 0;
+    PendienteCadena *cadena = NULL;
+    uint32_t num_cadena = 0, capacidad_cadena = 0;
+    const NodoArbol **operandos = NULL;
+    uint32_t capacidad_operandos = 0;
+
+    raiz = sin_parentesis(raiz);
+    uint32_t indice_raiz = agregar_nodo(nario, raiz);
+    int correcto = indice_raiz != UINT32_MAX &&
+                   reservar((void**)&pendientes, &capacidad_pendientes, 1, sizeof(PendienteNario));
+    if (correcto) {
+        pendientes[0].indice = indice_raiz;
+        pendientes[0].binario = raiz;
+        pendientes[0].nivel = 1;
+        num_pendientes = 1;
+    }
+
+    while (correcto && num_pendientes > 0) {
+        PendienteNario actual = pendientes[--num_pendientes];
+        if (actual.nivel > nario->profundidad) {
+            nario->profundidad = actual.nivel;
+        }
+        if (actual.binario->tipo == NODO_IDENTIFICADOR) {
+            continue;
+        }
+
+        // Operandos de la cadena en orden: el derecho se apila primero. Un
+        // nodo del mismo operador se abre si es el operando izquierdo (o
+        // siempre, al reasociar); si no, es un operando más
+        unsigned char operador = actual.binario->tipo;
+        uint32_t num_operandos = 0;
+        num_cadena = 0;
+        correcto = reservar((void**)&cadena, &capacidad_cadena, 2, sizeof(PendienteCadena));
+        if (correcto) {
+            cadena[num_cadena].nodo = sin_parentesis(actual.binario->derecho);
+            cadena[num_cadena].izquierdo = 0;
+            num_cadena++;
+            cadena[num_cadena].nodo = sin_parentesis(actual.binario->izquierdo);
+            cadena[num_cadena].izquierdo = 1;
+            num_cadena++;
+        }
+        while (correcto && num_cadena > 0) {
+            PendienteCadena elemento = cadena[--num_cadena];
+            if (elemento.nodo->tipo == operador && (elemento.izquierdo || reasociar)) {
+                correcto = reservar((void**)&cadena, &capacidad_cadena, num_cadena + 2, sizeof(PendienteCadena));
+                if (correcto) {
+                    cadena[num_cadena].nodo = sin_parentesis(elemento.nodo->derecho);
+                    cadena[num_cadena].izquierdo = 0;
+                    num_cadena++;
+                    cadena[num_cadena].nodo = sin_parentesis(elemento.nodo->izquierdo);
+                    cadena[num_cadena].izquierdo = 1;
+                    num_cadena++;
+                }
+            } else {
+                correcto = reservar((void**)&operandos, &capacidad_operandos, num_operandos + 1,
+                                    sizeof(const NodoArbol*));
+                if (correcto) {
+                    operandos[num_operandos++] = elemento.nodo;
+                }
+            }
+        }
+
+        // Los operandos ocupan un tramo contiguo de 'hijos'
+        correcto = correcto &&
+                   reservar((void**)&nario->hijos, &nario->capacidad_hijos, nario->num_hijos + num_operandos,
+                            sizeof(uint32_t)) &&
+                   reservar((void**)&pendientes, &capacidad_pendientes, num_pendientes + num_operandos,
+                            sizeof(PendienteNario));
+        if (!correcto) {
+            break;
+        }
+        uint32_t primero = nario->num_hijos;
+        nario->num_hijos += num_operandos;
+        nario->nodos[actual.indice].primer_hijo = primero;
+        nario->nodos[actual.indice].num_hijos = num_operandos;
+        for (uint32_t k = 0; k < num_operandos && correcto; k++) {
+            uint32_t indice = agregar_nodo(nario, operandos[k]);
+            correcto = indice != UINT32_MAX;
+            if (correcto) {
+                nario->hijos[primero + k] = indice;
+            }
+        }
+        // Solo los operandos con operador quedan pendientes; se apilan en
+        // orden inverso para completar primero el de la izquierda
+        for (uint32_t k = num_operandos; k-- > 0 && correcto; ) {
+            if (operandos[k]->tipo == NODO_IDENTIFICADOR) {
+                if (actual.nivel + 1 > nario->profundidad) {
+                    nario->profundidad = actual.nivel + 1;
+                }
+                continue;
+            }
+            pendientes[num_pendientes].indice = nario->hijos[primero + k];
+            pendientes[num_pendientes].binario = operandos[k];
+            pendientes[num_pendientes].nivel = actual.nivel + 1;
+            num_pendientes++;
+        }
+    }
+
+    free(pendientes);
+    free(cadena);
+    free(operandos);
+    if (!correcto) {
+        nario->num_nodos = 0;
+        nario->num_hijos = 0;
+        nario->profundidad = 0;
+    }
+    return correcto;
+}
+
+// Elemento pendiente del recorrido en preorden de imprimir_arbol_nario
+typedef struct {
+    uint32_t indice;
+    int nivel;
+} PendienteImpresionNario;
+
+void imprimir_arbol_nario(Salida *salida, const ArbolNario *nario) {
+    if (nario->num_nodos == 0) return;
+
+    uint32_t capacidad = 64;
+    uint32_t cantidad = 0;
+    PendienteImpresionNario *pila = (PendienteImpresionNario*)malloc(capacidad * sizeof(PendienteImpresionNario));
+    if (!pila) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para imprimir el árbol\n");
+        return;
+    }
+    pila[cantidad].indice = 0;
+    pila[cantidad].nivel = 0;
+    cantidad++;
+
+    while (cantidad > 0) {
+        cantidad--;
+        const NodoNario *actual = &nario->nodos[pila[cantidad].indice];
+        int nivel_actual = pila[cantidad].nivel;
+
+        salida_repetir(salida, ' ', 2 * (size_t)nivel_actual);
+        if (actual->valor) {
+            salida_printf(salida, "%s: %s\n", tipo_nodo_a_string((TipoNodo)actual->tipo), actual->valor);
+        } else {
+            salida_printf(salida, "%s: %u operandos\n", tipo_nodo_a_string((TipoNodo)actual->tipo), actual->num_hijos);
+        }
+
+        if (!reservar((void**)&pila, &capacidad, cantidad + actual->num_hijos, sizeof(PendienteImpresionNario))) {
+            break;
+        }
+        // Los operandos se apilan al revés para visitarlos de izquierda a derecha
+        for (uint32_t k = actual->num_hijos; k-- > 0; ) {
+            pila[cantidad].indice = nario->hijos[actual->primer_hijo + k];
+            pila[cantidad].nivel = nivel_actual + 1;
+            cantidad++;
+        }
+    }
+
+    free(pila);
+}
@@ -0,0 +1,52 @@
+#ifndef NARIO_H
+#define NARIO_H
+
+#include <stdint.h>
+#include "parser.h"
+
+// Forma normalizada n-aria del árbol: cada cadena de un mismo operador
+// (a + b + c + ...) es un solo nodo con sus operandos en un tramo contiguo
+// de 'hijos', y no hay nodos de paréntesis (la agrupación queda en la
+// anidación). La profundidad sigue la anidación real de la expresión y no
+// la longitud de las cadenas. Los operandos están en orden de izquierda a
+// derecha y un nodo n-ario se evalúa en ese orden
+
+// Nodo n-ario. En los identificadores 'valor' es el nombre (el mismo puntero
+// que en el árbol original, interno a la tabla de símbolos del parser)
+typedef struct {
+    const char *valor;
+    uint32_t primer_hijo;  // Índice en 'hijos' del primer operando
+    uint32_t num_hijos;    // 0 en los identificadores, 2 o más en el resto
+    Simbolo simbolo;
+    int linea;
+    int columna;
+    uint8_t tipo;          // NODO_IDENTIFICADOR, NODO_SUMA o NODO_MULTIPLICACION
+} NodoNario;
+
+// Árbol n-ario: la raíz es el nodo 0 y cada nodo está antes que sus
+// operandos
+typedef struct {
+    NodoNario *nodos;
+    uint32_t num_nodos;
+    uint32_t capacidad_nodos;
+    uint32_t *hijos;
+    uint32_t num_hijos;
+    uint32_t capacidad_hijos;
+    uint32_t profundidad;  // Niveles de nodos (1 para un identificador)
+} ArbolNario;
+
+// Funciones del árbol n-ario
+void nario_iniciar(ArbolNario *nario);
+void nario_liberar(ArbolNario *nario);
+
+// Construye la forma n-aria de 'raiz' (reemplaza el contenido anterior).
+// La cadena izquierda de un operador, que es lo que produce el parser, se
+// aplana siempre: ((a + b) + c) da los mismos resultados como a + b + c.
+// Con 'reasociar' también se aplana un operando derecho con el mismo
+// operador, a + (b + c), lo que en coma flotante puede cambiar el redondeo.
+// Devuelve 0 si falta memoria
+int nario_desde_arbol(ArbolNario *nario, const NodoArbol *raiz, int reasociar);
+
+void imprimir_arbol_nario(Salida *salida, const ArbolNario *nario);
+
+#endif // NARIO_H
@@ -1,13 +1,55 @@
 #include "parser.h"
 
+#define TAMANO_BLOQUE_ARENA (16 * 1024)
+
+// Arena donde el parser crea sus nodos (NULL: un malloc por nodo)
+static Arena* arena_nodos(Parser *parser) {
+    return parser->usar_arena ? &parser->arena : NULL;
+}
+
+// Crea un nodo operador, compartido si así lo indica el parser
+static NodoArbol* nuevo_nodo(Parser *parser, TipoNodo tipo, const char *valor, NodoArbol *izq, NodoArbol *der, int linea, int columna) {
+    if (parser->compartir_nodos) {
+        return crear_nodo_compartido(&parser->nodos, &parser->arena, tipo, valor, SIMBOLO_NINGUNO,
+                                     izq, der, linea, columna);
+    }
+    return crear_nodo(arena_nodos(parser), tipo, valor, izq, der, linea, columna);
+}
+
+// Crea el nodo del identificador del token actual
+static NodoArbol* nuevo_nodo_identificador(Parser *parser) {
+    Token *token = &parser->token_actual;
+    const char *nombre = token_texto(parser->lexer, token);
+    
+    if (parser->compartir_nodos) {
+        Simbolo simbolo = simbolos_internar(parser->simbolos, nombre, token->longitud);
+        if (simbolo == SIMBOLO_NINGUNO) return NULL;
+        return crear_nodo_compartido(&parser->nodos, &parser->arena, NODO_IDENTIFICADOR,
+                                     simbolos_nombre(parser->simbolos, simbolo), simbolo,
+                                     NULL, NULL, token->linea, token->columna);
+    }
+    return crear_nodo_identificador(arena_nodos(parser), parser->simbolos, nombre,
+                                    token->longitud, token->linea, token->columna);
+}
+
 Parser* crear_parser(const char *entrada) {
+    return crear_parser_n(entrada, strlen(entrada));
+}
+
+Parser* crear_parser_n(const char *entrada, int longitud) {
+    return crear_parser_con_simbolos(entrada, longitud, NULL);
+}
+
+// Con 'simbolos' NULL el parser usa una tabla propia; una tabla compartida
+// debe vivir más que los árboles de todos los parsers que la usan
+Parser* crear_parser_con_simbolos(const char *entrada, int longitud, TablaSimbolos *simbolos) {
     Parser *parser = (Parser*)malloc(sizeof(Parser));
     if (!parser) {
         fprintf(stderr, "Error: No se pudo asignar memoria para el parser\n");
         return NULL;
     }
     
-    parser->lexer = crear_lexer(entrada);
+    parser->lexer = crear_lexer_n(entrada, longitud);
     if (!parser->lexer) {
         free(parser);
         return NULL;
@@ -15,6 +57,14 @@ Parser* crear_parser(const char *entrada) {
     
     parser->hay_error = 0;
     parser->mensaje_error[0] = '\0';
+    parser->usar_arena = 1;
+    arena_iniciar(&parser->arena, TAMANO_BLOQUE_ARENA);
+    simbolos_iniciar(&parser->simbolos_propios);
+    parser->simbolos = simbolos ? simbolos : &parser->simbolos_propios;
+    parser->compartir_nodos = 0;
+    tabla_nodos_iniciar(&parser->nodos);
+    parser->pila = NULL;
+    parser->capacidad_pila = 0;
     
     // Obtener el primer token
     parser->token_actual = obtener_siguiente_token(parser->lexer);
@@ -22,18 +72,37 @@ Parser* crear_parser(const char *entrada) {
     return parser;
 }
 
+// Analizar otra entrada con el mismo parser. Se conservan las opciones
+// (usar_arena, compartir_nodos) y la tabla de símbolos compartida; la propia
+// se vacía para que los símbolos se numeren como en un parser nuevo
+void reiniciar_parser(Parser *parser, const char *entrada, int longitud) {
+    reiniciar_lexer(parser->lexer, entrada, longitud);
+    parser->hay_error = 0;
+    parser->mensaje_error[0] = '\0';
+    arena_reiniciar(&parser->arena);
+    if (parser->simbolos == &parser->simbolos_propios) {
+        simbolos_vaciar(&parser->simbolos_propios);
+    }
+    tabla_nodos_vaciar(&parser->nodos);
+    
+    // Obtener el primer token
+    parser->token_actual = obtener_siguiente_token(parser->lexer);
+}
+
 void liberar_parser(Parser *parser) {
     if (parser) {
         if (parser->lexer) {
             liberar_lexer(parser->lexer);
         }
-        liberar_token(&parser->token_actual);
+        arena_liberar(&parser->arena);
+        simbolos_liberar(&parser->simbolos_propios);
+        tabla_nodos_liberar(&parser->nodos);
+        free(parser->pila);
         free(parser);
     }
 }
 
 void avanzar_token(Parser *parser) {
-    liberar_token(&parser->token_actual);
     parser->token_actual = obtener_siguiente_token(parser->lexer);
 }
 
@@ -53,45 +122,96 @@ void reportar_error(Parser *parser, const char *mensaje) {
              mensaje, tipo_token_a_string(parser->token_actual.tipo));
 }
 
-void imprimir_error(Parser *parser) {
+void imprimir_error(Salida *salida, Parser *parser) {
     if (parser->hay_error) {
-        printf("%s\n", parser->mensaje_error);
+        salida_printf(salida, "%s\n", parser->mensaje_error);
+    }
+}
+
+// Copia un valor de 'longitud' bytes en la arena o, sin arena, con malloc
+static char* copiar_valor(Arena *arena, const char *valor, size_t longitud) {
+    if (arena) {
+        return arena_copiar_cadena(arena, valor, longitud);
+    }
+    
+    char *copia = (char*)malloc(longitud + 1);
+    if (copia) {
+        memcpy(copia, valor, longitud);
+        copia[longitud] = '\0';
     }
+    return copia;
 }
 
-NodoArbol* crear_nodo(TipoNodo tipo, const char *valor, NodoArbol *izq, NodoArbol *der, int linea, int columna) {
-    NodoArbol *nodo = (NodoArbol*)malloc(sizeof(NodoArbol));
+NodoArbol* crear_nodo(Arena *arena, TipoNodo tipo, const char *valor, NodoArbol *izq, NodoArbol *der, int linea, int columna) {
+    NodoArbol *nodo;
+    if (arena) {
+        nodo = (NodoArbol*)arena_asignar(arena, sizeof(NodoArbol));
+    } else {
+        nodo = (NodoArbol*)malloc(sizeof(NodoArbol));
+    }
     if (!nodo) {
         fprintf(stderr, "Error: No se pudo asignar memoria para el nodo\n");
         return NULL;
     }
     
-    nodo->tipo = tipo;
+    nodo->tipo = (unsigned char)tipo;
+    nodo->en_arena = arena != NULL;
+    nodo->compartido = 0;
+    nodo->simbolo = SIMBOLO_NINGUNO;
     nodo->izquierdo = izq;
     nodo->derecho = der;
     nodo->linea = linea;
     nodo->columna = columna;
     
-    if (valor) {
-        nodo->valor = (char*)malloc(strlen(valor) + 1);
-        if (nodo->valor) {
-            strcpy(nodo->valor, valor);
-        }
-    } else {
+    if (!valor) {
         nodo->valor = NULL;
+    } else if (arena && strcmp(valor, tipo_nodo_a_string(tipo)) == 0) {
+        // Los operadores usan su representación constante, sin copiarla
+        nodo->valor = tipo_nodo_a_string(tipo);
+    } else {
+        nodo->valor = copiar_valor(arena, valor, strlen(valor));
     }
     
     return nodo;
 }
 
-void liberar_arbol(NodoArbol *nodo) {
+// Crea un nodo identificador a partir de un lexema que no termina en '\0';
+// el nombre se interna en 'simbolos' en lugar de copiarse en cada nodo
+NodoArbol* crear_nodo_identificador(Arena *arena, TablaSimbolos *simbolos, const char *nombre, size_t longitud, int linea, int columna) {
+    Simbolo simbolo = simbolos_internar(simbolos, nombre, longitud);
+    if (simbolo == SIMBOLO_NINGUNO) {
+        return NULL;
+    }
+    
+    NodoArbol *nodo = crear_nodo(arena, NODO_IDENTIFICADOR, NULL, NULL, NULL, linea, columna);
     if (nodo) {
-        liberar_arbol(nodo->izquierdo);
-        liberar_arbol(nodo->derecho);
-        if (nodo->valor) {
-            free(nodo->valor);
+        nodo->simbolo = simbolo;
+        nodo->valor = (char*)simbolos_nombre(simbolos, simbolo);
+    }
+    return nodo;
+}
+
+// Libera el árbol sin recursión: cada hijo izquierdo se rota a la derecha
+// hasta que el nodo no tiene hijo izquierdo y puede liberarse
+void liberar_arbol(NodoArbol *nodo) {
+    // Un árbol construido en la arena se libera completo con su parser
+    if (!nodo || nodo->en_arena) return;
+    
+    while (nodo) {
+        if (nodo->izquierdo) {
+            NodoArbol *izquierdo = nodo->izquierdo;
+            nodo->izquierdo = izquierdo->derecho;
+            izquierdo->derecho = nodo;
+            nodo = izquierdo;
+        } else {
+            NodoArbol *derecho = nodo->derecho;
+            // Los nombres internados pertenecen a la tabla de símbolos
+            if (nodo->simbolo == SIMBOLO_NINGUNO) {
+                free(nodo->valor);
+            }
+            free(nodo);
+            nodo = derecho;
         }
-        free(nodo);
     }
 }
 
@@ -108,25 +228,63 @@ char* tipo_nodo_a_string(TipoNodo tipo) {
     }
 }
 
-void imprimir_arbol(NodoArbol *nodo, int nivel) {
+// Elemento pendiente del recorrido en preorden de imprimir_arbol
+typedef struct {
+    NodoArbol *nodo;
+    int nivel;
+} PendienteImpresion;
+
+// Imprime el árbol en preorden con una pila en el heap, sin recursión
+void imprimir_arbol(Salida *salida, NodoArbol *nodo, int nivel) {
     if (!nodo) return;
     
-    for (int i = 0; i < nivel; i++) {
-        printf("  ");
+    int capacidad = 64;
+    int cantidad = 0;
+    PendienteImpresion *pila = (PendienteImpresion*)malloc(capacidad * sizeof(PendienteImpresion));
+    if (!pila) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para imprimir el árbol\n");
+        return;
     }
+    pila[cantidad].nodo = nodo;
+    pila[cantidad].nivel = nivel;
+    cantidad++;
     
-    printf("%s", tipo_nodo_a_string(nodo->tipo));
-    if (nodo->valor) {
-        printf(": %s", nodo->valor);
+    while (cantidad > 0) {
+        cantidad--;
+        NodoArbol *actual = pila[cantidad].nodo;
+        int nivel_actual = pila[cantidad].nivel;
+        
+        salida_repetir(salida, ' ', 2 * (size_t)nivel_actual);
+        salida_escribir_cadena(salida, tipo_nodo_a_string(actual->tipo));
+        if (actual->valor) {
+            salida_escribir(salida, ": ", 2);
+            salida_escribir_cadena(salida, actual->valor);
+        }
+        salida_escribir(salida, "\n", 1);
+        
+        if (cantidad + 2 > capacidad) {
+            capacidad *= 2;
+            PendienteImpresion *nueva = (PendienteImpresion*)realloc(pila, capacidad * sizeof(PendienteImpresion));
+            if (!nueva) {
+                fprintf(stderr, "Error: No se pudo asignar memoria para imprimir el árbol\n");
+                break;
+            }
+            pila = nueva;
+        }
+        // El derecho se apila primero para visitar antes el izquierdo
+        if (actual->derecho) {
+            pila[cantidad].nodo = actual->derecho;
+            pila[cantidad].nivel = nivel_actual + 1;
+            cantidad++;
+        }
+        if (actual->izquierdo) {
+            pila[cantidad].nodo = actual->izquierdo;
+            pila[cantidad].nivel = nivel_actual + 1;
+            cantidad++;
+        }
     }
-    printf("\n");
     
-    if (nodo->izquierdo) {
-        imprimir_arbol(nodo->izquierdo, nivel + 1);
-    }
-    if (nodo->derecho) {
-        imprimir_arbol(nodo->derecho, nivel + 1);
-    }
+    free(pila);
 }
 
 // E -> T E'
@@ -152,7 +310,7 @@ NodoArbol* analizar_E_prima(Parser *parser, NodoArbol *izquierdo) {
         NodoArbol *termino = analizar_T(parser);
         if (!termino || parser->hay_error) return NULL;
         
-        NodoArbol *nodo_suma = crear_nodo(NODO_SUMA, "+", izquierdo, termino, linea, columna);
+        NodoArbol *nodo_suma = nuevo_nodo(parser, NODO_SUMA, "+", izquierdo, termino, linea, columna);
         
         return analizar_E_prima(parser, nodo_suma);
     }
@@ -184,7 +342,7 @@ NodoArbol* analizar_T_prima(Parser *parser, NodoArbol *izquierdo) {
         NodoArbol *factor = analizar_F(parser);
         if (!factor || parser->hay_error) return NULL;
         
-        NodoArbol *nodo_mult = crear_nodo(NODO_MULTIPLICACION, "*", izquierdo, factor, linea, columna);
+        NodoArbol *nodo_mult = nuevo_nodo(parser, NODO_MULTIPLICACION, "*", izquierdo, factor, linea, columna);
         
         return analizar_T_prima(parser, nodo_mult);
     }
@@ -213,14 +371,10 @@ NodoArbol* analizar_F(Parser *parser) {
         
         avanzar_token(parser); // consumir ')'
         
-        return crear_nodo(NODO_PARENTESIS, "()", expresion, NULL, linea, columna);
+        return nuevo_nodo(parser, NODO_PARENTESIS, "()", expresion, NULL, linea, columna);
         
     } else if (parser->token_actual.tipo == TOKEN_IDENTIFICADOR) {
-        int linea = parser->token_actual.linea;
-        int columna = parser->token_actual.columna;
-        char *valor = parser->token_actual.valor;
-        
-        NodoArbol *nodo = crear_nodo(NODO_IDENTIFICADOR, valor, NULL, NULL, linea, columna);
+        NodoArbol *nodo = nuevo_nodo_identificador(parser);
         avanzar_token(parser);
         
         return nodo;
@@ -231,29 +385,206 @@ NodoArbol* analizar_F(Parser *parser) {
     }
 }
 
-NodoArbol* analizar(Parser *parser) {
+// Estado de una expresión entre paréntesis que aún no termina:
+// la suma y el producto acumulados a la izquierda del operador pendiente
+struct MarcoAnalisis {
+    NodoArbol *suma;
+    NodoArbol *producto;
+    int linea_suma, columna_suma;
+    int linea_producto, columna_producto;
+    int linea_paren, columna_paren;
+};
+
+static MarcoAnalisis* apilar_marco(Parser *parser, int *profundidad) {
+    if (*profundidad + 1 >= parser->capacidad_pila) {
+        int capacidad = parser->capacidad_pila ? parser->capacidad_pila * 2 : 32;
+        MarcoAnalisis *pila = (MarcoAnalisis*)realloc(parser->pila, capacidad * sizeof(MarcoAnalisis));
+        if (!pila) {
+            fprintf(stderr, "Error: No se pudo asignar memoria para la pila del parser\n");
+            return NULL;
+        }
+        parser->pila = pila;
+        parser->capacidad_pila = capacidad;
+    }
+    
+    MarcoAnalisis *marco = &parser->pila[++(*profundidad)];
+    marco->suma = NULL;
+    marco->producto = NULL;
+    return marco;
+}
+
+// Sin arena, libera los subárboles acumulados en la pila tras un error
+static NodoArbol* abandonar(Parser *parser, int profundidad) {
+    for (int i = 0; i <= profundidad; i++) {
+        liberar_arbol(parser->pila[i].suma);
+        liberar_arbol(parser->pila[i].producto);
+    }
+    return NULL;
+}
+
+// E -> T E', T -> F T', F -> ( E ) | ident sin recursión.
+// Produce los mismos árboles y errores que analizar_E: los bucles de '+' y '*'
+// reemplazan a E' y T', y cada '(' apila un marco en lugar de una llamada
+NodoArbol* analizar_expresion_iterativo(Parser *parser) {
+    if (parser->hay_error) return NULL;
+    
+    int profundidad = -1;
+    MarcoAnalisis *marco = apilar_marco(parser, &profundidad);
+    if (!marco) return NULL;
+    
+    while (1) {
+        // F: abrir paréntesis o leer un identificador
+        Token *token = &parser->token_actual;
+        NodoArbol *factor;
+        
+        if (token->tipo == TOKEN_PAREN_IZQ) {
+            int linea = token->linea;
+            int columna = token->columna;
+            marco = apilar_marco(parser, &profundidad);
+            if (!marco) return abandonar(parser, profundidad);
+            marco->linea_paren = linea;
+            marco->columna_paren = columna;
+            avanzar_token(parser); // consumir '('
+            continue;
+        } else if (token->tipo == TOKEN_IDENTIFICADOR) {
+            factor = nuevo_nodo_identificador(parser);
+            avanzar_token(parser);
+        } else {
+            reportar_error(parser, "Se esperaba identificador o '('");
+            return abandonar(parser, profundidad);
+        }
+        
+        // Con un factor completo, reducir T y E; al cerrar un paréntesis el
+        // resultado es a su vez un factor del marco anterior
+        while (1) {
+            if (marco->producto) {
+                factor = nuevo_nodo(parser, NODO_MULTIPLICACION, "*", marco->producto, factor,
+                                    marco->linea_producto, marco->columna_producto);
+                marco->producto = NULL;
+            }
+            if (parser->token_actual.tipo == TOKEN_MULTIPLICACION) {
+                marco->producto = factor;
+                marco->linea_producto = parser->token_actual.linea;
+                marco->columna_producto = parser->token_actual.columna;
+                avanzar_token(parser); // consumir '*'
+                break;
+            }
+            
+            if (marco->suma) {
+                factor = nuevo_nodo(parser, NODO_SUMA, "+", marco->suma, factor,
+                                    marco->linea_suma, marco->columna_suma);
+                marco->suma = NULL;
+            }
+            if (parser->token_actual.tipo == TOKEN_SUMA) {
+                marco->suma = factor;
+                marco->linea_suma = parser->token_actual.linea;
+                marco->columna_suma = parser->token_actual.columna;
+                avanzar_token(parser); // consumir '+'
+                break;
+            }
+            
+            // E completa
+            if (profundidad == 0) {
+                return factor;
+            }
+            if (parser->token_actual.tipo != TOKEN_PAREN_DER) {
+                reportar_error(parser, "Se esperaba ')'");
+                liberar_arbol(factor);
+                return abandonar(parser, profundidad);
+            }
+            avanzar_token(parser); // consumir ')'
+            
+            factor = nuevo_nodo(parser, NODO_PARENTESIS, "()", factor, NULL,
+                                marco->linea_paren, marco->columna_paren);
+            marco = &parser->pila[--profundidad];
+        }
+    }
+}
+
+// Devuelve el árbol o NULL; en caso de error el mensaje queda en parser->mensaje_error
+static NodoArbol* analizar_con(Parser *parser, NodoArbol* (*analizar_expresion)(Parser*)) {
     if (parser->token_actual.tipo == TOKEN_ERROR) {
-        printf("Error léxico: %s en línea %d, columna %d\n",
-               parser->token_actual.valor,
-               parser->token_actual.linea,
-               parser->token_actual.columna);
+        parser->hay_error = 1;
+        snprintf(parser->mensaje_error, sizeof(parser->mensaje_error),
+                 "Error léxico: Carácter no reconocido: '%c' en línea %d, columna %d",
+                 *token_texto(parser->lexer, &parser->token_actual),
+                 parser->token_actual.linea,
+                 parser->token_actual.columna);
         return NULL;
     }
     
-    NodoArbol *arbol = analizar_E(parser);
+    NodoArbol *arbol = analizar_expresion(parser);
     
     if (parser->hay_error) {
-        imprimir_error(parser);
         liberar_arbol(arbol);
         return NULL;
     }
     
-    if (parser->token_actual.tipo != TOKEN_EOF) {
-        reportar_error(parser, "Se esperaba fin de entrada");
-        imprimir_error(parser);
+    if (parser->token_actual.tipo != TOKEN_EOF && parser->token_actual.tipo != TOKEN_FIN_SENTENCIA) {
+        reportar_error(parser, parser->lexer->separadores ? "Se esperaba fin de sentencia" : "Se esperaba fin de entrada");
         liberar_arbol(arbol);
         return NULL;
     }
     
     return arbol;
-}
\ No newline at end of file
+}
+
+NodoArbol* analizar(Parser *parser) {
+    return analizar_con(parser, analizar_expresion_iterativo);
+}
+
+// Misma interfaz que analizar, con el descenso recursivo analizar_E
+NodoArbol* analizar_recursivo(Parser *parser) {
+    return analizar_con(parser, analizar_E);
+}
+
+long analizar_sentencias(Parser *parser, FuncionSentencia funcion, void *contexto, long *num_sentencias) {
+    const char *entrada = parser->lexer->entrada;
+    parser->lexer->separadores = 1;
+    reiniciar_parser(parser, entrada, parser->lexer->longitud);
+    
+    long sentencias = 0;
+    long errores = 0;
+    while (parser->token_actual.tipo != TOKEN_EOF) {
+        if (parser->token_actual.tipo == TOKEN_FIN_SENTENCIA) {
+            avanzar_token(parser); // sentencia vacía
+            continue;
+        }
+        
+        Token primero = parser->token_actual;
+        NodoArbol *arbol = analizar(parser);
+        
+        // Modo pánico: tras un error, sincronizar en el fin de la sentencia
+        while (parser->token_actual.tipo != TOKEN_FIN_SENTENCIA && parser->token_actual.tipo != TOKEN_EOF) {
+            avanzar_token(parser);
+        }
+        int fin = parser->token_actual.inicio;
+        while (fin > primero.inicio && (entrada[fin - 1] == ' ' || entrada[fin - 1] == '\t' || entrada[fin - 1] == '\n')) {
+            fin--;
+        }
+        
+        Sentencia sentencia;
+        sentencia.arbol = arbol;
+        sentencia.mensaje_error = arbol ? NULL : parser->mensaje_error;
+        sentencia.texto = entrada + primero.inicio;
+        sentencia.longitud = (size_t)(fin - primero.inicio);
+        sentencia.linea = primero.linea;
+        sentencia.columna = primero.columna;
+        sentencias++;
+        if (!arbol) {
+            errores++;
+        }
+        funcion(contexto, &sentencia);
+        
+        // La memoria de esta sentencia se reutiliza en la siguiente
+        liberar_arbol(arbol);
+        arena_reiniciar(&parser->arena);
+        tabla_nodos_vaciar(&parser->nodos);
+        parser->hay_error = 0;
+        parser->mensaje_error[0] = '\0';
+    }
+    
+    parser->lexer->separadores = 0;
+    *num_sentencias = sentencias;
+    return errores;
+}
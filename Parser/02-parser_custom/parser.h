@@ -2,6 +2,9 @@
 #define PARSER_H
 
 #include "lexer.h"
+#include "arena.h"
+#include "salida.h"
+#include "simbolos.h"
 
 // Tipos de nodos del árbol sintáctico
 typedef enum {
@@ -15,8 +18,16 @@ typedef enum {
 } TipoNodo;
 
 // Estructura para nodos del árbol sintáctico
+// Los nodos creados en una arena no se liberan individualmente (en_arena = 1)
+// En los identificadores, 'simbolo' es su número en la tabla de símbolos del
+// parser y 'valor' apunta al nombre internado (pertenece a la tabla).
+// 'tipo', 'en_arena' y 'compartido' ocupan un byte cada uno para que el
+// símbolo no agrande el nodo (40 bytes en 64 bits)
 typedef struct NodoArbol {
-    TipoNodo tipo;
+    unsigned char tipo; // TipoNodo
+    unsigned char en_arena;
+    unsigned char compartido; // creado por crear_nodo_compartido (dag.c)
+    Simbolo simbolo;
     char *valor;
     struct NodoArbol *izquierdo;
     struct NodoArbol *derecho;
@@ -24,26 +35,98 @@ typedef struct NodoArbol {
     int columna;
 } NodoArbol;
 
+// Tabla de nodos compartidos (hash consing): los subárboles estructuralmente
+// iguales (mismo tipo, mismo valor, mismos hijos) se crean una sola vez y el
+// resultado del análisis es un DAG. Direccionamiento abierto con sondeo lineal
+typedef struct NodoCompartido NodoCompartido;
+typedef struct {
+    NodoCompartido **casillas;
+    uint32_t capacidad_casillas;
+    uint32_t num_nodos;
+} TablaNodos;
+
+// Marco de la pila explícita del análisis iterativo (uno por paréntesis abierto)
+typedef struct MarcoAnalisis MarcoAnalisis;
+
 // Estructura para el parser
+// Con usar_arena activo (valor por defecto) los nodos del árbol y sus cadenas
+// se asignan en la arena del parser y se liberan juntos en liberar_parser.
+// Los identificadores se internan en 'simbolos': la tabla propia del parser
+// o una compartida entre varios parsers (crear_parser_con_simbolos).
+// Con compartir_nodos activo los subárboles repetidos se comparten (DAG);
+// esos nodos siempre se crean en la arena, aunque usar_arena sea 0.
+// reiniciar_parser prepara el mismo parser para otra entrada sin liberar su
+// memoria (lexer, arena, pila, tablas): en un bucle de muchas expresiones
+// cortas no hay reservas por expresión. Los árboles en la arena y los
+// nombres de la tabla propia dejan de ser válidos al reiniciar
 typedef struct {
     Lexer *lexer;
     Token token_actual;
     int hay_error;
     char mensaje_error[256];
+    int usar_arena;
+    Arena arena;
+    TablaSimbolos *simbolos;
+    TablaSimbolos simbolos_propios;
+    int compartir_nodos;
+    TablaNodos nodos;
+    MarcoAnalisis *pila;
+    int capacidad_pila;
 } Parser;
 
+// Sentencia de analizar_sentencias. El árbol y el mensaje solo valen durante
+// la llamada a la función que la recibe
+typedef struct {
+    NodoArbol *arbol;           // NULL si tiene un error
+    const char *mensaje_error;  // Mensaje de reportar_error (NULL si es válida)
+    const char *texto;          // Vista sobre la entrada, sin el separador
+    size_t longitud;
+    int linea;
+    int columna;
+} Sentencia;
+
+typedef void (*FuncionSentencia)(void *contexto, const Sentencia *sentencia);
+
 // Funciones del parser
 Parser* crear_parser(const char *entrada);
+Parser* crear_parser_n(const char *entrada, int longitud);
+Parser* crear_parser_con_simbolos(const char *entrada, int longitud, TablaSimbolos *simbolos);
 void liberar_parser(Parser *parser);
+void reiniciar_parser(Parser *parser, const char *entrada, int longitud);
 NodoArbol* analizar(Parser *parser);
+NodoArbol* analizar_recursivo(Parser *parser);
+
+// Analiza toda la entrada del parser como una secuencia de expresiones
+// separadas por saltos de línea o ';' (las vacías se ignoran), en una sola
+// pasada del lexer. Tras un error descarta tokens hasta el fin de la
+// sentencia y sigue con la siguiente, así que informa de todos los errores.
+// Llama a 'funcion' con cada sentencia, en orden; la memoria de cada árbol
+// se reutiliza para el siguiente. Devuelve el número de sentencias con
+// error y deja en *num_sentencias el total
+long analizar_sentencias(Parser *parser, FuncionSentencia funcion, void *contexto, long *num_sentencias);
 
 // Funciones para el árbol sintáctico
-NodoArbol* crear_nodo(TipoNodo tipo, const char *valor, NodoArbol *izq, NodoArbol *der, int linea, int columna);
+NodoArbol* crear_nodo(Arena *arena, TipoNodo tipo, const char *valor, NodoArbol *izq, NodoArbol *der, int linea, int columna);
+NodoArbol* crear_nodo_identificador(Arena *arena, TablaSimbolos *simbolos, const char *nombre, size_t longitud, int linea, int columna);
 void liberar_arbol(NodoArbol *nodo);
-void imprimir_arbol(NodoArbol *nodo, int nivel);
+void imprimir_arbol(Salida *salida, NodoArbol *nodo, int nivel);
 char* tipo_nodo_a_string(TipoNodo tipo);
 
+// Nodos compartidos (dag.c): en una misma tabla, dos subárboles son iguales
+// si y solo si son el mismo puntero. 'valor' no se copia: debe ser una cadena
+// constante o un nombre internado. Un nodo compartido conserva la posición
+// de su primera aparición
+void tabla_nodos_iniciar(TablaNodos *tabla);
+void tabla_nodos_liberar(TablaNodos *tabla);
+void tabla_nodos_vaciar(TablaNodos *tabla);  // Conserva las casillas
+NodoArbol* crear_nodo_compartido(TablaNodos *tabla, Arena *arena, TipoNodo tipo, const char *valor,
+                                 Simbolo simbolo, NodoArbol *izq, NodoArbol *der, int linea, int columna);
+uint32_t hash_estructural(const NodoArbol *nodo);
+
 // Funciones de análisis sintáctico (gramática LL(1))
+// Descenso recursivo, una función por no terminal; analizar usa en su lugar
+// una versión iterativa equivalente con pila explícita
+NodoArbol* analizar_expresion_iterativo(Parser *parser);
 NodoArbol* analizar_E(Parser *parser);
 NodoArbol* analizar_E_prima(Parser *parser, NodoArbol *izquierdo);
 NodoArbol* analizar_T(Parser *parser);
@@ -54,6 +137,6 @@ NodoArbol* analizar_F(Parser *parser);
 void avanzar_token(Parser *parser);
 int coincidir(Parser *parser, TipoToken tipo_esperado);
 void reportar_error(Parser *parser, const char *mensaje);
-void imprimir_error(Parser *parser);
+void imprimir_error(Salida *salida, Parser *parser);
 
 #endif // PARSER_H
\ No newline at end of file
@@ -0,0 +1,338 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "plano.h"
+
+#define PLANO_ORDEN_BYTES 0x01020304u
+
+void plano_iniciar(ArbolPlano *plano) {
+    memset(plano, 0, sizeof(*plano));
+    plano->raiz = PLANO_NINGUNO;
+}
+
+void plano_liberar(ArbolPlano *plano) {
+    if (plano->mapa) {
+        munmap(plano->mapa, plano->tamano_mapa);
+    } else {
+        free(plano->nodos);
+        free(plano->desplazamientos);
+        free(plano->nombres);
+    }
+    plano_iniciar(plano);
+}
+
+// Garantiza espacio para 'cantidad' elementos de 'tamano' bytes
+static int reservar(void **arreglo, uint32_t *capacidad, uint32_t cantidad, size_t tamano) {
+    if (cantidad <= *capacidad) {
+        return 1;
+    }
+    uint32_t nueva_capacidad = *capacidad ? *capacidad : 64;
+    while (nueva_capacidad < cantidad) {
+        nueva_capacidad *= 2;
+    }
+    void *nuevo = realloc(*arreglo, (size_t)nueva_capacidad * tamano);
+    if (!nuevo) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el árbol plano\n");
+        return 0;
+    }
+    *arreglo = nuevo;
+    *capacidad = nueva_capacidad;
+    return 1;
+}
+
+// Copia los nombres internados en el orden de sus símbolos
+static int copiar_nombres(ArbolPlano *plano, const TablaSimbolos *simbolos) {
+    uint32_t bytes = 0;
+    for (uint32_t i = 0; i < simbolos->num_simbolos; i++) {
+        bytes += simbolos->simbolos[i].longitud + 1;
+    }
+    if (!reservar((void**)&plano->desplazamientos, &plano->capacidad_nombres, simbolos->num_simbolos, sizeof(uint32_t)) ||
+        !reservar((void**)&plano->nombres, &plano->capacidad_bytes, bytes, 1)) {
+        return 0;
+    }
+
+    uint32_t desplazamiento = 0;
+    for (uint32_t i = 0; i < simbolos->num_simbolos; i++) {
+        const DatosSimbolo *datos = &simbolos->simbolos[i];
+        plano->desplazamientos[i] = desplazamiento;
+        memcpy(plano->nombres + desplazamiento, datos->nombre, datos->longitud + 1);
+        desplazamiento += datos->longitud + 1;
+    }
+    plano->num_nombres = simbolos->num_simbolos;
+    plano->bytes_nombres = bytes;
+    return 1;
+}
+
+// Elemento pendiente del recorrido en postorden de plano_desde_arbol
+typedef struct {
+    const NodoArbol *nodo;
+    int hijos_listos;
+} PendientePlano;
+
+// Convierte un árbol (o un DAG, que se expande) al formato plano sin
+// recursión. Los nombres se renumeran desde 0 en orden de aparición
+int plano_desde_arbol(ArbolPlano *plano, const NodoArbol *raiz) {
+    plano->num_nodos = 0;
+    plano->raiz = PLANO_NINGUNO;
+    plano->num_nombres = 0;
+    plano->bytes_nombres = 0;
+    if (!raiz) return 1;
+
+    TablaSimbolos simbolos;
+    simbolos_iniciar(&simbolos);
+
+    uint32_t capacidad = 64;
+    uint32_t pendientes = 0;
+    uint32_t listos = 0;
+    PendientePlano *pila = (PendientePlano*)malloc(capacidad * sizeof(PendientePlano));
+    uint32_t *indices = (uint32_t*)malloc(capacidad * sizeof(uint32_t));
+    int correcto = pila && indices;
+    if (correcto) {
+        pila[pendientes].nodo = raiz;
+        pila[pendientes].hijos_listos = 0;
+        pendientes++;
+    }
+
+    // Como en hash_estructural, cada nodo se visita al apilar sus hijos y
+    // otra vez, con los índices de sus hijos ya en 'indices', para emitirse
+    while (correcto && pendientes > 0) {
+        PendientePlano *actual = &pila[pendientes - 1];
+        const NodoArbol *n = actual->nodo;
+
+        if (actual->hijos_listos) {
+            pendientes--;
+            if (!reservar((void**)&plano->nodos, &plano->capacidad_nodos, plano->num_nodos + 1, sizeof(NodoPlano))) {
+                correcto = 0;
+                break;
+            }
+
+            NodoPlano *nodo = &plano->nodos[plano->num_nodos];
+            nodo->derecho = n->derecho ? indices[--listos] : PLANO_NINGUNO;
+            nodo->izquierdo = n->izquierdo ? indices[--listos] : PLANO_NINGUNO;
+            nodo->simbolo = SIMBOLO_NINGUNO;
+            if (n->tipo == NODO_IDENTIFICADOR && n->valor) {
+                nodo->simbolo = simbolos_internar(&simbolos, n->valor, strlen(n->valor));
+                if (nodo->simbolo == SIMBOLO_NINGUNO) {
+                    correcto = 0;
+                    break;
+                }
+            }
+            nodo->columna = n->columna > 0 ? (uint32_t)n->columna : 0;
+            nodo->linea = n->linea > UINT16_MAX ? UINT16_MAX : (n->linea > 0 ? (uint16_t)n->linea : 0);
+            nodo->tipo = n->tipo;
+            nodo->reservado = 0;
+            indices[listos++] = plano->num_nodos++;
+            continue;
+        }
+
+        actual->hijos_listos = 1;
+        if (pendientes + 2 > capacidad) {
+            capacidad *= 2;
+            PendientePlano *nueva_pila = (PendientePlano*)realloc(pila, capacidad * sizeof(PendientePlano));
+            uint32_t *nuevos_indices = nueva_pila ? (uint32_t*)realloc(indices, capacidad * sizeof(uint32_t)) : NULL;
+            if (nueva_pila) pila = nueva_pila;
+            if (nuevos_indices) indices = nuevos_indices;
+            if (!nueva_pila || !nuevos_indices) {
+                correcto = 0;
+                break;
+            }
+        }
+        if (n->derecho) {
+            pila[pendientes].nodo = n->derecho;
+            pila[pendientes].hijos_listos = 0;
+            pendientes++;
+        }
+        if (n->izquierdo) {
+            pila[pendientes].nodo = n->izquierdo;
+            pila[pendientes].hijos_listos = 0;
+            pendientes++;
+        }
+    }
+
+    if (correcto) {
+        plano->raiz = indices[0];
+        correcto = copiar_nombres(plano, &simbolos);
+    } else {
+        fprintf(stderr, "Error: No se pudo convertir el árbol al formato plano\n");
+    }
+
+    free(pila);
+    free(indices);
+    simbolos_liberar(&simbolos);
+    return correcto;
+}
+
+const char* plano_nombre(const ArbolPlano *plano, uint32_t simbolo) {
+    if (simbolo >= plano->num_nombres) {
+        return NULL;
+    }
+    return plano->nombres + plano->desplazamientos[simbolo];
+}
+
+// Elemento pendiente del recorrido en preorden de imprimir_arbol_plano
+typedef struct {
+    uint32_t indice;
+    int nivel;
+} PendienteImpresionPlano;
+
+// Imprime el árbol plano con el mismo formato que imprimir_arbol
+void imprimir_arbol_plano(Salida *salida, const ArbolPlano *plano) {
+    if (plano->raiz == PLANO_NINGUNO) return;
+
+    int capacidad = 64;
+    int cantidad = 0;
+    PendienteImpresionPlano *pila = (PendienteImpresionPlano*)malloc(capacidad * sizeof(PendienteImpresionPlano));
+    if (!pila) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para imprimir el árbol\n");
+        return;
+    }
+    pila[cantidad].indice = plano->raiz;
+    pila[cantidad].nivel = 0;
+    cantidad++;
+
+    while (cantidad > 0) {
+        cantidad--;
+        const NodoPlano *actual = &plano->nodos[pila[cantidad].indice];
+        int nivel_actual = pila[cantidad].nivel;
+
+        salida_repetir(salida, ' ', 2 * (size_t)nivel_actual);
+        const char *valor = actual->simbolo != SIMBOLO_NINGUNO ? plano_nombre(plano, actual->simbolo)
+                                                               : tipo_nodo_a_string((TipoNodo)actual->tipo);
+        salida_printf(salida, "%s: %s\n", tipo_nodo_a_string((TipoNodo)actual->tipo), valor);
+
+        if (cantidad + 2 > capacidad) {
+            capacidad *= 2;
+            PendienteImpresionPlano *nueva = (PendienteImpresionPlano*)realloc(pila, capacidad * sizeof(PendienteImpresionPlano));
+            if (!nueva) {
+                fprintf(stderr, "Error: No se pudo asignar memoria para imprimir el árbol\n");
+                break;
+            }
+            pila = nueva;
+        }
+        if (actual->derecho != PLANO_NINGUNO) {
+            pila[cantidad].indice = actual->derecho;
+            pila[cantidad].nivel = nivel_actual + 1;
+            cantidad++;
+        }
+        if (actual->izquierdo != PLANO_NINGUNO) {
+            pila[cantidad].indice = actual->izquierdo;
+            pila[cantidad].nivel = nivel_actual + 1;
+            cantidad++;
+        }
+    }
+
+    free(pila);
+}
+
+// Escribe la cabecera y los tres arreglos tal como están en memoria
+int plano_guardar(const ArbolPlano *plano, const char *nombre_archivo) {
+    FILE *archivo = fopen(nombre_archivo, "wb");
+    if (!archivo) {
+        return 0;
+    }
+
+    CabeceraPlano cabecera;
+    memset(&cabecera, 0, sizeof(cabecera));
+    memcpy(cabecera.magia, PLANO_MAGIA, 4);
+    cabecera.version = PLANO_VERSION;
+    cabecera.orden_bytes = PLANO_ORDEN_BYTES;
+    cabecera.tamano_nodo = sizeof(NodoPlano);
+    cabecera.num_nodos = plano->num_nodos;
+    cabecera.raiz = plano->raiz;
+    cabecera.num_nombres = plano->num_nombres;
+    cabecera.bytes_nombres = plano->bytes_nombres;
+
+    int correcto = fwrite(&cabecera, sizeof(cabecera), 1, archivo) == 1 &&
+                   fwrite(plano->nodos, sizeof(NodoPlano), plano->num_nodos, archivo) == plano->num_nodos &&
+                   fwrite(plano->desplazamientos, sizeof(uint32_t), plano->num_nombres, archivo) == plano->num_nombres &&
+                   fwrite(plano->nombres, 1, plano->bytes_nombres, archivo) == plano->bytes_nombres;
+
+    if (fclose(archivo) != 0) {
+        correcto = 0;
+    }
+    return correcto;
+}
+
+// Mapea un archivo de solo lectura: los arreglos del árbol apuntan
+// directamente al mapa
+int plano_mapear(ArbolPlano *plano, const char *nombre_archivo) {
+    plano_iniciar(plano);
+
+    int fd = open(nombre_archivo, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(CabeceraPlano)) {
+        close(fd);
+        return 0;
+    }
+
+    size_t tamano = (size_t)info.st_size;
+    void *mapa = mmap(NULL, tamano, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        return 0;
+    }
+
+    const CabeceraPlano *cabecera = (const CabeceraPlano*)mapa;
+    unsigned long long esperado = sizeof(CabeceraPlano)
+                                + (unsigned long long)cabecera->num_nodos * sizeof(NodoPlano)
+                                + (unsigned long long)cabecera->num_nombres * sizeof(uint32_t)
+                                + cabecera->bytes_nombres;
+    if (memcmp(cabecera->magia, PLANO_MAGIA, 4) != 0 ||
+        cabecera->version != PLANO_VERSION ||
+        cabecera->orden_bytes != PLANO_ORDEN_BYTES ||
+        cabecera->tamano_nodo != sizeof(NodoPlano) ||
+        esperado != tamano) {
+        munmap(mapa, tamano);
+        return 0;
+    }
+
+    char *datos = (char*)mapa + sizeof(CabeceraPlano);
+    plano->nodos = (NodoPlano*)datos;
+    plano->num_nodos = cabecera->num_nodos;
+    plano->raiz = cabecera->raiz;
+    datos += (size_t)cabecera->num_nodos * sizeof(NodoPlano);
+    plano->desplazamientos = (uint32_t*)datos;
+    plano->num_nombres = cabecera->num_nombres;
+    datos += (size_t)cabecera->num_nombres * sizeof(uint32_t);
+    plano->nombres = datos;
+    plano->bytes_nombres = cabecera->bytes_nombres;
+    plano->mapa = mapa;
+    plano->tamano_mapa = tamano;
+    return 1;
+}
+
+// Comprueba que todos los índices estén en rango y que los hijos precedan
+// al padre, de modo que los recorridos no puedan salirse ni entrar en ciclos
+int plano_validar(const ArbolPlano *plano) {
+    if (plano->num_nodos == 0) {
+        return plano->raiz == PLANO_NINGUNO;
+    }
+    if (plano->raiz >= plano->num_nodos) {
+        return 0;
+    }
+    if (plano->num_nombres > 0 && (plano->bytes_nombres == 0 || plano->nombres[plano->bytes_nombres - 1] != '\0')) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < plano->num_nombres; i++) {
+        if (plano->desplazamientos[i] >= plano->bytes_nombres) {
+            return 0;
+        }
+    }
+    for (uint32_t i = 0; i < plano->num_nodos; i++) {
+        const NodoPlano *nodo = &plano->nodos[i];
+        if (nodo->tipo > NODO_PARENTESIS ||
+            (nodo->izquierdo != PLANO_NINGUNO && nodo->izquierdo >= i) ||
+            (nodo->derecho != PLANO_NINGUNO && nodo->derecho >= i) ||
+            (nodo->simbolo != SIMBOLO_NINGUNO && nodo->simbolo >= plano->num_nombres)) {
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,73 @@
+#ifndef PLANO_H
+#define PLANO_H
+
+#include <stdint.h>
+#include "parser.h"
+
+// Representación plana del árbol: los nodos en un arreglo contiguo, en
+// postorden (los hijos antes que el padre, la raíz al final) y enlazados por
+// índices de 32 bits. El mismo arreglo es el contenido del archivo binario,
+// que se vuelve a usar con mmap sin ningún paso de deserialización
+
+// Índice de hijo ausente
+#define PLANO_NINGUNO UINT32_MAX
+
+// Nodo plano (20 bytes, sin punteros)
+typedef struct {
+    uint32_t izquierdo;  // Índice del hijo izquierdo o PLANO_NINGUNO
+    uint32_t derecho;    // Índice del hijo derecho o PLANO_NINGUNO
+    uint32_t simbolo;    // Identificadores: índice de su nombre; SIMBOLO_NINGUNO en el resto
+    uint32_t columna;
+    uint16_t linea;      // Se satura en UINT16_MAX
+    uint8_t tipo;        // TipoNodo
+    uint8_t reservado;
+} NodoPlano;
+
+// Árbol plano. Los nombres de los identificadores están en 'nombres',
+// terminados en '\0'; desplazamientos[i] es el inicio del nombre i
+typedef struct {
+    NodoPlano *nodos;
+    uint32_t num_nodos;
+    uint32_t raiz;
+    uint32_t *desplazamientos;
+    uint32_t num_nombres;
+    char *nombres;
+    uint32_t bytes_nombres;
+    // Arreglos propios (capacidades) o archivo mapeado
+    uint32_t capacidad_nodos;
+    uint32_t capacidad_nombres;
+    uint32_t capacidad_bytes;
+    void *mapa;
+    size_t tamano_mapa;
+} ArbolPlano;
+
+// Formato del archivo (versión 1, orden de bytes del equipo que lo escribe):
+// cabecera, nodos[num_nodos], desplazamientos[num_nombres], nombres
+#define PLANO_MAGIA "ASTP"
+#define PLANO_VERSION 1
+
+typedef struct {
+    char magia[4];
+    uint32_t version;
+    uint32_t orden_bytes;  // 0x01020304 escrito en el orden nativo
+    uint32_t tamano_nodo;  // sizeof(NodoPlano)
+    uint32_t num_nodos;
+    uint32_t raiz;
+    uint32_t num_nombres;
+    uint32_t bytes_nombres;
+} CabeceraPlano;
+
+// Funciones del árbol plano
+void plano_iniciar(ArbolPlano *plano);
+void plano_liberar(ArbolPlano *plano);
+int plano_desde_arbol(ArbolPlano *plano, const NodoArbol *raiz);
+const char* plano_nombre(const ArbolPlano *plano, uint32_t simbolo);
+void imprimir_arbol_plano(Salida *salida, const ArbolPlano *plano);
+
+// Archivo binario: plano_mapear solo comprueba la cabecera y los tamaños;
+// plano_validar recorre los nodos y debe usarse con archivos no confiables
+int plano_guardar(const ArbolPlano *plano, const char *nombre_archivo);
+int plano_mapear(ArbolPlano *plano, const char *nombre_archivo);
+int plano_validar(const ArbolPlano *plano);
+
+#endif // PLANO_H
@@ -0,0 +1,196 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "pool.h"
+
+// Cola circular de tareas de un hilo
+typedef struct {
+    size_t *tareas;
+    size_t capacidad;
+    size_t inicio;
+    size_t cantidad;
+    pthread_mutex_t mutex;
+} ColaTrabajo;
+
+typedef struct {
+    Pool *pool;
+    int indice;
+} ArgumentoHilo;
+
+struct Pool {
+    int num_hilos;
+    pthread_t *hilos;
+    ArgumentoHilo *argumentos;
+    ColaTrabajo *colas;
+    FuncionTarea funcion;
+    void *contexto;
+    
+    // Protege 'pendientes' y 'terminar'; los hilos sin trabajo esperan en 'hay_trabajo'
+    pthread_mutex_t mutex;
+    pthread_cond_t hay_trabajo;
+    size_t pendientes;
+    int terminar;
+    int siguiente_cola;
+};
+
+static int cola_agregar(ColaTrabajo *cola, size_t tarea) {
+    pthread_mutex_lock(&cola->mutex);
+    if (cola->cantidad == cola->capacidad) {
+        size_t capacidad = cola->capacidad ? cola->capacidad * 2 : 64;
+        size_t *tareas = (size_t*)malloc(capacidad * sizeof(size_t));
+        if (!tareas) {
+            pthread_mutex_unlock(&cola->mutex);
+            return 0;
+        }
+        for (size_t i = 0; i < cola->cantidad; i++) {
+            tareas[i] = cola->tareas[(cola->inicio + i) % cola->capacidad];
+        }
+        free(cola->tareas);
+        cola->tareas = tareas;
+        cola->capacidad = capacidad;
+        cola->inicio = 0;
+    }
+    cola->tareas[(cola->inicio + cola->cantidad) % cola->capacidad] = tarea;
+    cola->cantidad++;
+    pthread_mutex_unlock(&cola->mutex);
+    return 1;
+}
+
+// Toma una tarea del frente (hilo dueño) o del final (robo)
+static int cola_tomar(ColaTrabajo *cola, int robar, size_t *tarea) {
+    int encontrada = 0;
+    pthread_mutex_lock(&cola->mutex);
+    if (cola->cantidad > 0) {
+        if (robar) {
+            *tarea = cola->tareas[(cola->inicio + cola->cantidad - 1) % cola->capacidad];
+        } else {
+            *tarea = cola->tareas[cola->inicio];
+            cola->inicio = (cola->inicio + 1) % cola->capacidad;
+        }
+        cola->cantidad--;
+        encontrada = 1;
+    }
+    pthread_mutex_unlock(&cola->mutex);
+    return encontrada;
+}
+
+static int buscar_tarea(Pool *pool, int propia, size_t *tarea) {
+    if (cola_tomar(&pool->colas[propia], 0, tarea)) {
+        return 1;
+    }
+    for (int i = 1; i < pool->num_hilos; i++) {
+        if (cola_tomar(&pool->colas[(propia + i) % pool->num_hilos], 1, tarea)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void* ejecutar_hilo(void *argumento) {
+    ArgumentoHilo *arg = (ArgumentoHilo*)argumento;
+    Pool *pool = arg->pool;
+    size_t tarea;
+    
+    while (1) {
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->pendientes == 0 && !pool->terminar) {
+            pthread_cond_wait(&pool->hay_trabajo, &pool->mutex);
+        }
+        if (pool->pendientes == 0) {
+            pthread_mutex_unlock(&pool->mutex);
+            break;
+        }
+        // Reservar una tarea; alguna cola la contiene con seguridad
+        pool->pendientes--;
+        pthread_mutex_unlock(&pool->mutex);
+        
+        while (!buscar_tarea(pool, arg->indice, &tarea)) {
+            // Otro hilo tomó una tarea durante el recorrido; hay al menos una más
+        }
+        pool->funcion(pool->contexto, tarea);
+    }
+    
+    return NULL;
+}
+
+Pool* crear_pool(int num_hilos, FuncionTarea funcion, void *contexto) {
+    Pool *pool = (Pool*)calloc(1, sizeof(Pool));
+    if (!pool) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el pool de hilos\n");
+        return NULL;
+    }
+    
+    pool->num_hilos = num_hilos;
+    pool->funcion = funcion;
+    pool->contexto = contexto;
+    pool->hilos = (pthread_t*)calloc((size_t)num_hilos, sizeof(pthread_t));
+    pool->argumentos = (ArgumentoHilo*)calloc((size_t)num_hilos, sizeof(ArgumentoHilo));
+    pool->colas = (ColaTrabajo*)calloc((size_t)num_hilos, sizeof(ColaTrabajo));
+    if (!pool->hilos || !pool->argumentos || !pool->colas) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para el pool de hilos\n");
+        free(pool->hilos);
+        free(pool->argumentos);
+        free(pool->colas);
+        free(pool);
+        return NULL;
+    }
+    
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->hay_trabajo, NULL);
+    for (int i = 0; i < num_hilos; i++) {
+        pthread_mutex_init(&pool->colas[i].mutex, NULL);
+    }
+    
+    for (int i = 0; i < num_hilos; i++) {
+        pool->argumentos[i].pool = pool;
+        pool->argumentos[i].indice = i;
+        if (pthread_create(&pool->hilos[i], NULL, ejecutar_hilo, &pool->argumentos[i]) != 0) {
+            fprintf(stderr, "Error: No se pudo crear el hilo %d\n", i);
+            pool->num_hilos = i;
+            liberar_pool(pool);
+            return NULL;
+        }
+    }
+    
+    return pool;
+}
+
+// Reparte las tareas entre las colas de los hilos en turno rotativo
+void pool_enviar(Pool *pool, size_t tarea) {
+    int indice = pool->siguiente_cola;
+    pool->siguiente_cola = (pool->siguiente_cola + 1) % pool->num_hilos;
+    
+    if (!cola_agregar(&pool->colas[indice], tarea)) {
+        // Sin memoria para encolar: ejecutar la tarea en el hilo que la envía
+        pool->funcion(pool->contexto, tarea);
+        return;
+    }
+    
+    pthread_mutex_lock(&pool->mutex);
+    pool->pendientes++;
+    pthread_cond_signal(&pool->hay_trabajo);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+// Espera a que terminen todas las tareas enviadas y libera el pool
+void liberar_pool(Pool *pool) {
+    pthread_mutex_lock(&pool->mutex);
+    pool->terminar = 1;
+    pthread_cond_broadcast(&pool->hay_trabajo);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    for (int i = 0; i < pool->num_hilos; i++) {
+        pthread_join(pool->hilos[i], NULL);
+    }
+    
+    for (int i = 0; i < pool->num_hilos; i++) {
+        pthread_mutex_destroy(&pool->colas[i].mutex);
+        free(pool->colas[i].tareas);
+    }
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->hay_trabajo);
+    free(pool->hilos);
+    free(pool->argumentos);
+    free(pool->colas);
+    free(pool);
+}
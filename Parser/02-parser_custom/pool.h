@@ -0,0 +1,18 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+// Función que ejecuta una tarea; 'tarea' es el índice enviado con pool_enviar
+typedef void (*FuncionTarea)(void *contexto, size_t tarea);
+
+// Pool de hilos con robo de trabajo: cada hilo tiene su propia cola, toma
+// tareas del frente de la suya y, si está vacía, roba del final de las demás
+typedef struct Pool Pool;
+
+// Funciones del pool
+Pool* crear_pool(int num_hilos, FuncionTarea funcion, void *contexto);
+void pool_enviar(Pool *pool, size_t tarea);
+void liberar_pool(Pool *pool);
+
+#endif // POOL_H
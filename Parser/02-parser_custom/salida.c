@@ -0,0 +1,102 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "salida.h"
+
+#define SALIDA_CAPACIDAD_INICIAL 4096
+
+void salida_iniciar(Salida *salida) {
+    salida->datos = NULL;
+    salida->longitud = 0;
+    salida->capacidad = 0;
+}
+
+// Garantiza espacio para 'extra' bytes más el '\0' final
+static int reservar(Salida *salida, size_t extra) {
+    size_t necesario = salida->longitud + extra + 1;
+    if (necesario <= salida->capacidad) {
+        return 1;
+    }
+    
+    size_t capacidad = salida->capacidad ? salida->capacidad : SALIDA_CAPACIDAD_INICIAL;
+    while (capacidad < necesario) {
+        capacidad *= 2;
+    }
+    
+    char *datos = (char*)realloc(salida->datos, capacidad);
+    if (!datos) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la salida\n");
+        return 0;
+    }
+    salida->datos = datos;
+    salida->capacidad = capacidad;
+    return 1;
+}
+
+void salida_escribir(Salida *salida, const char *texto, size_t longitud) {
+    if (!reservar(salida, longitud)) return;
+    memcpy(salida->datos + salida->longitud, texto, longitud);
+    salida->longitud += longitud;
+    salida->datos[salida->longitud] = '\0';
+}
+
+void salida_escribir_cadena(Salida *salida, const char *texto) {
+    salida_escribir(salida, texto, strlen(texto));
+}
+
+// Escribe 'veces' copias de 'caracter' (la sangría del árbol) de una vez
+void salida_repetir(Salida *salida, char caracter, size_t veces) {
+    if (!reservar(salida, veces)) return;
+    memset(salida->datos + salida->longitud, caracter, veces);
+    salida->longitud += veces;
+    salida->datos[salida->longitud] = '\0';
+}
+
+void salida_printf(Salida *salida, const char *formato, ...) {
+    va_list argumentos;
+    
+    // Primer intento con el espacio disponible; si no alcanza, se amplía y se repite
+    size_t disponible = salida->capacidad > salida->longitud ? salida->capacidad - salida->longitud : 0;
+    va_start(argumentos, formato);
+    int escritos = vsnprintf(disponible ? salida->datos + salida->longitud : NULL, disponible, formato, argumentos);
+    va_end(argumentos);
+    if (escritos < 0) return;
+    
+    if ((size_t)escritos >= disponible) {
+        if (!reservar(salida, (size_t)escritos)) return;
+        va_start(argumentos, formato);
+        vsnprintf(salida->datos + salida->longitud, (size_t)escritos + 1, formato, argumentos);
+        va_end(argumentos);
+    }
+    salida->longitud += (size_t)escritos;
+}
+
+// Vuelca el buffer con write sobre el descriptor de 'destino', sin pasar
+// por el buffer de stdio (que antes se vacía para conservar el orden)
+void salida_volcar(Salida *salida, FILE *destino) {
+    if (salida->longitud == 0) return;
+    
+    fflush(destino);
+    int fd = fileno(destino);
+    const char *pendiente = salida->datos;
+    size_t restante = salida->longitud;
+    while (restante > 0) {
+        ssize_t escritos = write(fd, pendiente, restante);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        pendiente += escritos;
+        restante -= (size_t)escritos;
+    }
+    salida->longitud = 0;
+}
+
+void salida_liberar(Salida *salida) {
+    free(salida->datos);
+    salida_iniciar(salida);
+}
@@ -0,0 +1,24 @@
+#ifndef SALIDA_H
+#define SALIDA_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+// Buffer de salida reutilizable: el texto se acumula en memoria y se vuelca
+// de una vez con write, lo que permite ordenar la salida de varios hilos
+typedef struct {
+    char *datos;
+    size_t longitud;
+    size_t capacidad;
+} Salida;
+
+// Funciones del buffer de salida
+void salida_iniciar(Salida *salida);
+void salida_escribir(Salida *salida, const char *texto, size_t longitud);
+void salida_escribir_cadena(Salida *salida, const char *texto);
+void salida_repetir(Salida *salida, char caracter, size_t veces);
+void salida_printf(Salida *salida, const char *formato, ...);
+void salida_volcar(Salida *salida, FILE *destino);
+void salida_liberar(Salida *salida);
+
+#endif // SALIDA_H
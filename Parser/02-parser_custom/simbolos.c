@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "simbolos.h"
+
+#define SIMBOLOS_CASILLAS_INICIALES 256
+#define SIMBOLOS_BLOQUE_NOMBRES (16 * 1024)
+
+// FNV-1a de 32 bits
+static uint32_t hash_nombre(const char *nombre, size_t longitud) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < longitud; i++) {
+        hash ^= (unsigned char)nombre[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void simbolos_iniciar(TablaSimbolos *tabla) {
+    tabla->casillas = NULL;
+    tabla->capacidad_casillas = 0;
+    tabla->simbolos = NULL;
+    tabla->num_simbolos = 0;
+    tabla->capacidad_simbolos = 0;
+    arena_iniciar(&tabla->nombres, SIMBOLOS_BLOQUE_NOMBRES);
+}
+
+void simbolos_liberar(TablaSimbolos *tabla) {
+    free(tabla->casillas);
+    free(tabla->simbolos);
+    arena_liberar(&tabla->nombres);
+    simbolos_iniciar(tabla);
+}
+
+void simbolos_vaciar(TablaSimbolos *tabla) {
+    if (tabla->casillas) {
+        memset(tabla->casillas, 0, tabla->capacidad_casillas * sizeof(uint32_t));
+    }
+    tabla->num_simbolos = 0;
+    arena_reiniciar(&tabla->nombres);
+}
+
+// Duplica el arreglo de casillas y reubica los símbolos existentes
+// (el hash guardado evita recalcularlo)
+static int crecer_casillas(TablaSimbolos *tabla) {
+    uint32_t capacidad = tabla->capacidad_casillas ? tabla->capacidad_casillas * 2 : SIMBOLOS_CASILLAS_INICIALES;
+    uint32_t *casillas = (uint32_t*)calloc(capacidad, sizeof(uint32_t));
+    if (!casillas) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la tabla de símbolos\n");
+        return 0;
+    }
+
+    uint32_t mascara = capacidad - 1;
+    for (uint32_t i = 0; i < tabla->num_simbolos; i++) {
+        uint32_t casilla = tabla->simbolos[i].hash & mascara;
+        while (casillas[casilla]) {
+            casilla = (casilla + 1) & mascara;
+        }
+        casillas[casilla] = i + 1;
+    }
+
+    free(tabla->casillas);
+    tabla->casillas = casillas;
+    tabla->capacidad_casillas = capacidad;
+    return 1;
+}
+
+static int crecer_simbolos(TablaSimbolos *tabla) {
+    uint32_t capacidad = tabla->capacidad_simbolos ? tabla->capacidad_simbolos * 2 : SIMBOLOS_CASILLAS_INICIALES / 2;
+    DatosSimbolo *simbolos = (DatosSimbolo*)realloc(tabla->simbolos, capacidad * sizeof(DatosSimbolo));
+    if (!simbolos) {
+        fprintf(stderr, "Error: No se pudo asignar memoria para la tabla de símbolos\n");
+        return 0;
+    }
+
+    tabla->simbolos = simbolos;
+    tabla->capacidad_simbolos = capacidad;
+    return 1;
+}
+
+// Devuelve el símbolo de 'nombre' (no necesita terminar en '\0'),
+// agregándolo a la tabla si es la primera vez que aparece
+Simbolo simbolos_internar(TablaSimbolos *tabla, const char *nombre, size_t longitud) {
+    if (longitud > UINT32_MAX) {
+        return SIMBOLO_NINGUNO;
+    }
+
+    // Factor de carga máximo de 1/2: las búsquedas fallidas siguen siendo cortas
+    if ((tabla->num_simbolos + 1) * 2 > tabla->capacidad_casillas && !crecer_casillas(tabla)) {
+        return SIMBOLO_NINGUNO;
+    }
+
+    uint32_t hash = hash_nombre(nombre, longitud);
+    uint32_t mascara = tabla->capacidad_casillas - 1;
+    uint32_t casilla = hash & mascara;
+
+    while (tabla->casillas[casilla]) {
+        const DatosSimbolo *datos = &tabla->simbolos[tabla->casillas[casilla] - 1];
+        if (datos->hash == hash && datos->longitud == longitud &&
+            memcmp(datos->nombre, nombre, longitud) == 0) {
+            return tabla->casillas[casilla] - 1;
+        }
+        casilla = (casilla + 1) & mascara;
+    }
+
+    if (tabla->num_simbolos == tabla->capacidad_simbolos && !crecer_simbolos(tabla)) {
+        return SIMBOLO_NINGUNO;
+    }
+
+    char *copia = arena_copiar_cadena(&tabla->nombres, nombre, longitud);
+    if (!copia) {
+        return SIMBOLO_NINGUNO;
+    }
+
+    Simbolo simbolo = tabla->num_simbolos++;
+    tabla->simbolos[simbolo].nombre = copia;
+    tabla->simbolos[simbolo].longitud = (uint32_t)longitud;
+    tabla->simbolos[simbolo].hash = hash;
+    tabla->casillas[casilla] = simbolo + 1;
+    return simbolo;
+}
+
+const char* simbolos_nombre(const TablaSimbolos *tabla, Simbolo simbolo) {
+    if (simbolo >= tabla->num_simbolos) {
+        return NULL;
+    }
+    return tabla->simbolos[simbolo].nombre;
+}
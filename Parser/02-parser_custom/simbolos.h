@@ -0,0 +1,41 @@
+#ifndef SIMBOLOS_H
+#define SIMBOLOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+
+// Identificador de símbolo: índice compacto de 32 bits en la tabla
+typedef uint32_t Simbolo;
+
+// Valor de 'simbolo' en los nodos que no son identificadores internados
+#define SIMBOLO_NINGUNO UINT32_MAX
+
+// Datos de un símbolo internado (el nombre termina en '\0')
+typedef struct {
+    const char *nombre;
+    uint32_t longitud;
+    uint32_t hash;
+} DatosSimbolo;
+
+// Tabla de internado de identificadores: cada nombre se guarda una sola vez
+// y se identifica por su Simbolo. Direccionamiento abierto con sondeo lineal;
+// cada casilla guarda el número de símbolo + 1 (0 = casilla libre).
+// Los nombres viven en la arena de la tabla y no cambian de dirección.
+typedef struct {
+    uint32_t *casillas;
+    uint32_t capacidad_casillas;
+    DatosSimbolo *simbolos;
+    uint32_t num_simbolos;
+    uint32_t capacidad_simbolos;
+    Arena nombres;
+} TablaSimbolos;
+
+// Funciones de la tabla de símbolos
+void simbolos_iniciar(TablaSimbolos *tabla);
+void simbolos_liberar(TablaSimbolos *tabla);
+void simbolos_vaciar(TablaSimbolos *tabla);  // Olvida los nombres, conserva la memoria
+Simbolo simbolos_internar(TablaSimbolos *tabla, const char *nombre, size_t longitud);
+const char* simbolos_nombre(const TablaSimbolos *tabla, Simbolo simbolo);
+
+#endif // SIMBOLOS_H